@@ -0,0 +1,147 @@
+#ifndef BITBOARD_H_
+#define BITBOARD_H_
+
+#include <stdint.h>
+
+/*
+ * A Bitboard is a 64-bit set with one bit per grid of the board. Grid (x, y)
+ * of ChessBoard::m_board maps onto bit (y * 8 + x), so the white back rank
+ * occupies the lowest eight bits and "up" (y + 1) is a shift by eight.
+ */
+typedef uint64_t Bitboard;
+
+const int NO_SQUARE = -1;
+
+/*
+ * enum Direction - The eight ray directions used by the sliding pieces
+ *
+ * Description: The first four directions increase the square index, the last
+ * four decrease it; the sliding attack lookup relies on this ordering
+ */
+enum Direction
+{
+	UP, RIGHT, UP_RIGHT, UP_LEFT, DOWN, LEFT, DOWN_LEFT, DOWN_RIGHT
+};
+
+extern Bitboard knight_attacks[64];
+extern Bitboard king_attacks[64];
+extern Bitboard pawn_attacks[2][64];
+extern Bitboard ray_attacks[8][64];
+extern Bitboard between_bits[64][64];
+extern Bitboard line_bits[64][64];
+
+void initAttackTables(void);
+
+inline int square(int x, int y)
+{
+	return (y * 8 + x);
+}
+
+inline int squareX(int sq)
+{
+	return (sq & 7);
+}
+
+inline int squareY(int sq)
+{
+	return (sq >> 3);
+}
+
+inline Bitboard squareBit(int sq)
+{
+	return (1ULL << sq);
+}
+
+inline int lsb(Bitboard b)
+{
+	return (__builtin_ctzll(b));
+}
+
+inline int msb(Bitboard b)
+{
+	return (63 - __builtin_clzll(b));
+}
+
+inline int popCount(Bitboard b)
+{
+	return (__builtin_popcountll(b));
+}
+
+inline int popLsb(Bitboard &b)
+{
+	int sq;
+
+	sq = lsb(b);
+	b &= b - 1;
+	return (sq);
+}
+
+inline Bitboard knightAttacks(int sq)
+{
+	return (knight_attacks[sq]);
+}
+
+inline Bitboard kingAttacks(int sq)
+{
+	return (king_attacks[sq]);
+}
+
+/*
+ * pawnAttacks - Grids a pawn of the given color standing on sq captures on
+ */
+inline Bitboard pawnAttacks(int sq, bool black)
+{
+	return (pawn_attacks[black][sq]);
+}
+
+/*
+ * slide - Grids reachable from sq along one direction, up to and including
+ * the first occupied grid
+ */
+inline Bitboard slide(int sq, Bitboard occupied, int dir)
+{
+	Bitboard attacks, blockers;
+
+	attacks = ray_attacks[dir][sq];
+	blockers = attacks & occupied;
+	if (blockers)
+		attacks ^= ray_attacks[dir][dir < DOWN ? lsb(blockers) : msb(blockers)];
+	return (attacks);
+}
+
+inline Bitboard bishopAttacks(int sq, Bitboard occupied)
+{
+	return (slide(sq, occupied, UP_RIGHT) | slide(sq, occupied, UP_LEFT) |
+			slide(sq, occupied, DOWN_LEFT) | slide(sq, occupied, DOWN_RIGHT));
+}
+
+inline Bitboard rookAttacks(int sq, Bitboard occupied)
+{
+	return (slide(sq, occupied, UP) | slide(sq, occupied, RIGHT) |
+			slide(sq, occupied, DOWN) | slide(sq, occupied, LEFT));
+}
+
+inline Bitboard queenAttacks(int sq, Bitboard occupied)
+{
+	return (bishopAttacks(sq, occupied) | rookAttacks(sq, occupied));
+}
+
+/*
+ * betweenBits - Grids strictly between a and b when they share a rank, file
+ * or diagonal, an empty set otherwise
+ */
+inline Bitboard betweenBits(int a, int b)
+{
+	return (between_bits[a][b]);
+}
+
+/*
+ * lineBits - The whole rank, file or diagonal running through a and b, an
+ * empty set when they are not aligned
+ */
+inline Bitboard lineBits(int a, int b)
+{
+	return (line_bits[a][b]);
+}
+
+#endif
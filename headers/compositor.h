@@ -0,0 +1,62 @@
+#ifndef COMPOSITOR_H_
+#define COMPOSITOR_H_
+
+#include "view.h"
+
+/*
+ * enum Layer - Target textures stacked by the Compositor, bottom first
+ */
+enum Layer
+{
+	BACKGROUND_LAYER, HIGHLIGHT_LAYER, PIECE_LAYER, HUD_LAYER, LAYER_COUNT
+};
+
+/**
+ * Compositor - Keeps each layer of the window in its own target texture, so
+ * a change only re-renders the area it touches on the layer it belongs to and
+ * a frame is just the layers copied on top of each other
+ *
+ * @m_renderer: Renderer the layers belong to
+ * @m_layers: One transparent target texture per Layer
+ * @m_width: Width of every layer
+ * @m_height: Height of every layer
+ */
+class Compositor {
+private:
+	SDL_Renderer *m_renderer;
+	SDL_Texture *m_layers[LAYER_COUNT];
+	int m_width;
+	int m_height;
+
+	void destroyLayers(void);
+
+public:
+	Compositor(SDL_Renderer *, int, int);
+	~Compositor(void);
+
+	bool resize(int, int);
+	void begin(Layer);
+	void clearRect(const SDL_Rect *);
+	void clearRects(const SDL_Rect *, int);
+	void clear(void);
+	void end(void);
+	void compose(void);
+	void present(void);
+
+	SDL_Texture *getLayer(Layer layer) const
+	{
+		return (m_layers[layer]);
+	};
+
+	int getWidth(void) const
+	{
+		return (m_width);
+	};
+
+	int getHeight(void) const
+	{
+		return (m_height);
+	};
+};
+
+#endif
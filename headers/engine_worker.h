@@ -0,0 +1,85 @@
+#ifndef ENGINE_WORKER_H_
+#define ENGINE_WORKER_H_
+
+#include "search.h"
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+/**
+ * struct EngineRequest - A position posted to the EngineWorker
+ *
+ * @id: Number identifying the request in the events it produces
+ * @pos: Copy of the position to search
+ * @limits: When the search should stop, all 0 to analyse until cancelled
+ */
+struct EngineRequest
+{
+	int id;
+	Position pos;
+	SearchLimits limits;
+};
+
+/**
+ * EngineWorker - Runs the engine on its own thread so the UI thread never
+ * waits for a search. The UI posts positions onto a queue and gets
+ * SDL user events back: progressEvent() after every completed iteration and
+ * bestMoveEvent() when a search ends. Each event carries the request id in
+ * user.code and a heap allocated SearchResult in user.data1, which the
+ * receiver deletes
+ *
+ * @m_engine: Engine the requests are searched with
+ * @m_thread: Thread the searches run on
+ * @m_mutex: Guards m_queue
+ * @m_wake: Signalled when a request is posted or the worker must quit
+ * @m_queue: Requests waiting for the worker, at most the newest one since a
+ * post supersedes everything before it
+ * @m_latest: Id of the newest request, searches of older ones are stopped
+ * @m_running: Id of the request being searched, only used by the worker
+ * @m_quit: Raised when the worker must exit
+ * @m_event_base: First of the two SDL event types registered for the worker
+ */
+class EngineWorker {
+private:
+	LazySmp *m_engine;
+	std::thread m_thread;
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::deque<EngineRequest *> m_queue;
+	std::atomic<int> m_latest;
+	int m_running;
+	std::atomic<bool> m_quit;
+	Uint32 m_event_base;
+
+	static void report(const SearchResult *, void *);
+	void loop(void);
+	void discardQueue(void);
+	void pushResult(Uint32, int, const SearchResult &);
+
+public:
+	EngineWorker(LazySmp *);
+	~EngineWorker(void);
+
+	int post(const Position &, const SearchLimits &);
+	void cancel(void);
+
+	bool isCurrent(int id) const
+	{
+		return (id == m_latest);
+	};
+
+	Uint32 progressEvent(void) const
+	{
+		return (m_event_base);
+	};
+
+	Uint32 bestMoveEvent(void) const
+	{
+		return (m_event_base + 1);
+	};
+};
+
+#endif
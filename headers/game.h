@@ -5,10 +5,39 @@ class Piece;
 class King;
 
 #include "view.h"
+#include "compositor.h"
+#include "sprite_batch.h"
+#include "hud.h"
 #include "moves.h"
+#include "position.h"
+#include "search.h"
 #include <stdio.h>
 #include <vector>
 
+// Initial size of the window, which may then be resized
+const int SCREEN_WIDTH = 800;
+const int SCREEN_HEIGHT = 600;
+
+const int MAX_ANIMATIONS = 2;
+
+/**
+ * struct Animation - A piece sprite gliding from one grid to another
+ *
+ * @sprite: Sprite of the piece
+ * @from_x: x position of the grid the piece leaves
+ * @from_y: y position of the grid the piece leaves
+ * @to_x: x position of the grid the piece lands on
+ * @to_y: y position of the grid the piece lands on
+ */
+struct Animation
+{
+	int sprite;
+	int from_x;
+	int from_y;
+	int to_x;
+	int to_y;
+};
+
 enum HighlightType
 {
 	PIECE, MOVE, CAPTURE, CASTLING
@@ -19,14 +48,36 @@ enum HighlightType
  * together in a class
  *
  * @m_board: A two-dimensional representation of the chess board
+ * @m_position: Bitboard mirror of m_board queried by the rule code
+ * @m_legal: Grids the piece on each grid may legally move to, computed from
+ * m_position on first use after every move
+ * @m_legal_captures: The part of m_legal that captures, en passant included
+ * @m_legal_castles: Grids the king of the side to move castles to
+ * @m_legal_valid: Whether or not the m_legal* cache matches m_position
+ * @m_draw: Rule the game was drawn by with the last move, NO_DRAW if none
  * @m_renderer: SDL_Renderer to use to render the pieces onto the board
  * @m_board_size: Size of the board
+ * @m_grid_size: Size of each grid
  * @m_board_pad: Padding of the board
+ * @m_sprite_inset: Offset of the sprites from the top left of their grid
  * @m_black_turn: Whether or not it is black's turn
  * @m_black_pieces: An std::vector of the black pieces
  * @m_white_pieces: An std::vector of the white pieces
- * @m_last_move: A record of the last move played
  * @m_chess_board: Pointer to an SDL_Texture of the chess board
+ * @m_atlas: Piece and overlay sprites packed into one texture
+ * @m_compositor: Layers the board is rendered onto
+ * @m_batch: Sprites of a layer update, drawn together in one call
+ * @m_hud: Metrics overlay drawn in the strip right of the board
+ * @m_overlays: Overlay sprite wanted on each grid, -1 for none
+ * @m_drawn_pieces: Piece sprite currently on the piece layer at each grid
+ * @m_drawn_overlays: Overlay sprite currently on the highlight layer at each
+ * grid
+ * @m_background_drawn: Whether or not the background layer is up to date
+ * @m_animations: Pieces gliding to their grid, hidden on the piece layer
+ * until they land
+ * @m_animation_count: Number of pieces in m_animations
+ * @m_animation_start: SDL_GetTicks() when the animations started
+ * @m_animation_time: Milliseconds a move takes to animate, 0 for none
  * @m_black_king: Pointer to the black king
  * @m_white_king: Pointer to the white king
  */
@@ -35,34 +86,86 @@ private:
 	int m_board_size;
 	int m_grid_size;
 	float m_board_pad;
+	int m_sprite_inset;
 	bool m_black_turn;
 
 	std::vector < Piece * > m_black_pieces;
 	std::vector < Piece * > m_white_pieces;
 	Piece *m_board[8][8];
-	Move *m_last_move;
+	Position m_position;
+	Bitboard m_legal[64];
+	Bitboard m_legal_captures[64];
+	Bitboard m_legal_castles;
+	bool m_legal_valid;
+	DrawState m_draw;
 	SDL_Texture *m_chess_board;
+	TextureAtlas *m_atlas;
+	Compositor *m_compositor;
+	SpriteBatch *m_batch;
+	Hud *m_hud;
+	int m_overlays[8][8];
+	int m_drawn_pieces[8][8];
+	int m_drawn_overlays[8][8];
+	bool m_background_drawn;
+	Animation m_animations[MAX_ANIMATIONS];
+	int m_animation_count;
+	Uint32 m_animation_start;
+	int m_animation_time;
 	SDL_Renderer *m_renderer;
 	King *m_black_king;
 	King *m_white_king;
 
 public:
-	ChessBoard(SDL_Renderer *, const int);
+	ChessBoard(SDL_Renderer *);
 	~ChessBoard(void);
+	void layout(int, int);
+	void resize(int, int);
 	void initBoard(void);
+	Piece *newPiece(PieceType, int, int, bool);
+	void clearPieces(void);
+	bool setFen(const char *);
+	int getFen(char *) const;
 	void drawBoard(void);
+	void render(void);
+	void renderFrame(int [8][8]);
+	void renderPosition(const Position &);
+	void invalidate(void);
+
+	void animateLastMove(void);
+	void drawAnimations(void);
+
+	bool isAnimating(void) const
+	{
+		return (m_animation_count > 0);
+	};
+
+	void setAnimationTime(int ms)
+	{
+		m_animation_time = ms;
+	};
+
+	void toggleHud(void)
+	{
+		m_hud->toggle();
+	};
+	void clearHighlights(void);
+	SDL_Rect gridRect(int, int, int) const;
+	void renderLayer(Layer, int [8][8], int [8][8]);
 
 	void highlight(int, int, HighlightType);
-	void highlightRoute(Piece *, bool pinned = false);
+	void highlightRoute(Piece *);
 	void highlightInterceptRoute(Piece *);
 
 	void updatePieceIntercept(void);
 
-	void movePiece(Piece *, int, int);
-	void setLastMove(int, int, int, int, PieceType);
+	void movePiece(Piece *, int, int, PieceType promotion = QUEEN);
+	void playMove(CompactMove);
+	void updateLegalCache(void);
+	Bitboard legalTargets(const Piece *);
+	bool isLegalMove(const Piece *, int, int);
+	void promotePawn(Piece *, PieceType);
 
 	void highlightKingRoutes(Piece *);
-	void highlightPawnRoutes(Piece *);
 	void highlightKnightRoutes(Piece *, bool);
 	void highlightStraight(Piece *, bool);
 	void highlightDiagonal(Piece *, bool);
@@ -78,7 +181,18 @@ public:
 		return (m_grid_size);
 	};
 
+	int getBoardSize(void) const
+	{
+		return (m_board_size);
+	};
+
 	bool isSafe(Piece *, int, int);
+	bool isExposed(Piece *, int, int);
+
+	bool isAttacked(int x, int y, bool by_black) const
+	{
+		return (m_position.isAttacked(square(x, y), by_black));
+	};
 	bool underCheck(Piece *);
 
 	bool blackTurn(void)
@@ -94,6 +208,8 @@ public:
 
 	void flipTurn(void)
 	{
+		// m_position already handed the turn over, and hashed it, in
+		// movePiece
 		m_black_turn = !m_black_turn;
 	};
 
@@ -117,19 +233,58 @@ public:
 		return (m_board[x][y]);
 	};
 
+	uint64_t getKey(void) const
+	{
+		return (m_position.key());
+	};
+
+	const Position &getPosition(void) const
+	{
+		return (m_position);
+	};
+
+	void generateLegalMoves(MoveList &list) const
+	{
+		m_position.generateLegalMoves(list);
+	};
+
 	King *pieceKing(Piece *);
 	Piece *trackDiagonal(Piece *, int, int);
 	Piece *trackStraight(Piece *, int, int);
 	Piece *routeBlocked(Piece *, int, int);
 
-	Move *getLastMove(void) const
+	DrawState drawState(void) const
+	{
+		return (m_draw);
+	};
+
+	CompactMove getLastMove(void) const
+	{
+		return (m_position.lastMove());
+	};
+
+	int historySize(void) const
+	{
+		return (m_position.undoSize());
+	};
+
+	const UndoRecord &history(int ply) const
 	{
-		return (m_last_move);
+		return (m_position.history(ply));
 	};
 };
 
-void start(void);
+void start(int, const char *, int, const char *, const char *, int);
+void headless(const char *, const char *, int);
 void eventHandler(SDL_Event *);
+float pixelScale(void);
+bool loadGame(const char *, int);
+void stepReplay(int);
+bool gameDrawn(void);
+void afterMove(void);
+void postAnalysis(void);
+void engineEvent(SDL_Event *);
+void playEngineMove(const SearchResult *);
 bool isPieceTurn(const Piece *);
 
 #endif
@@ -0,0 +1,177 @@
+#ifndef GAME_DB_H_
+#define GAME_DB_H_
+
+#include "pgn.h"
+#include <stddef.h>
+#include <vector>
+
+// First bytes of every game database file, the last one being the version
+const char GAME_DB_MAGIC[8] = { 'C', 'H', 'E', 'S', 'S', 'D', 'B', '1' };
+
+/**
+ * GameDbHeader - Start of a game database file. The sections follow it,
+ * each 8 byte aligned, in native byte order
+ *
+ * @magic: GAME_DB_MAGIC
+ * @game_count: Number of records in the game table
+ * @move_count: Number of moves in the move section
+ * @index_count: Number of entries in the position index
+ * @string_size: Size of the string pool in bytes
+ * @games_offset: Offset of the game table
+ * @moves_offset: Offset of the moves, CompactMove::raw() of every move of
+ * every game one after another
+ * @strings_offset: Offset of the string pool, null terminated strings
+ * starting with an empty one
+ * @index_offset: Offset of the position index
+ */
+struct GameDbHeader
+{
+	char magic[8];
+	uint64_t game_count;
+	uint64_t move_count;
+	uint64_t index_count;
+	uint64_t string_size;
+	uint64_t games_offset;
+	uint64_t moves_offset;
+	uint64_t strings_offset;
+	uint64_t index_offset;
+};
+
+/**
+ * GameDbRecord - A game of the game table. The tags are offsets into the
+ * string pool, 0 standing for the empty string
+ *
+ * @first_move: Index of the first move of the game in the move section
+ * @move_count: Number of moves of the game
+ * @event: Event tag
+ * @date: Date tag
+ * @white: White tag
+ * @black: Black tag
+ * @result: Result of the game
+ * @fen: FEN the game starts from, empty for the start position
+ */
+struct GameDbRecord
+{
+	uint64_t first_move;
+	uint32_t move_count;
+	uint32_t event;
+	uint32_t date;
+	uint32_t white;
+	uint32_t black;
+	uint32_t result;
+	uint32_t fen;
+};
+
+/**
+ * GameDbEntry - A position of the index, which holds one entry for every
+ * position of every game, the start included, sorted by key
+ *
+ * @key: Zobrist key of the position
+ * @game: Game reaching the position
+ * @ply: Number of moves of the game played to reach it
+ */
+struct GameDbEntry
+{
+	uint64_t key;
+	uint32_t game;
+	uint32_t ply;
+};
+
+/**
+ * GameDbWriter - Collects games and writes them out as a game database.
+ * Everything is held in memory until write, the position index included
+ *
+ * @m_games: Game table
+ * @m_moves: Moves of every game
+ * @m_strings: String pool
+ * @m_index: Position index, sorted by write
+ * @m_board: Position the games are replayed on to find their keys
+ */
+class GameDbWriter {
+private:
+	std::vector<GameDbRecord> m_games;
+	std::vector<uint16_t> m_moves;
+	std::vector<char> m_strings;
+	std::vector<GameDbEntry> m_index;
+	Position m_board;
+
+	uint32_t addString(const char *);
+
+public:
+	GameDbWriter(void);
+
+	bool add(const PgnGame &);
+	bool write(const char *);
+
+	uint64_t games(void) const
+	{
+		return (m_games.size());
+	};
+
+	uint64_t positions(void) const
+	{
+		return (m_index.size());
+	};
+};
+
+/**
+ * GameDb - A game database mapped into memory read only. Nothing is loaded,
+ * the pages are read in by the kernel as the queries touch them
+ *
+ * @m_map: Start of the mapping, nullptr when no file is open
+ * @m_size: Size of the mapping
+ * @m_header: Header of the file
+ * @m_games: Game table
+ * @m_moves: Moves of every game
+ * @m_strings: String pool
+ * @m_index: Position index
+ */
+class GameDb {
+private:
+	const char *m_map;
+	size_t m_size;
+	const GameDbHeader *m_header;
+	const GameDbRecord *m_games;
+	const uint16_t *m_moves;
+	const char *m_strings;
+	const GameDbEntry *m_index;
+
+public:
+	GameDb(void);
+	~GameDb(void);
+
+	bool open(const char *);
+	void close(void);
+
+	uint64_t gameCount(void) const
+	{
+		return (m_header ? m_header->game_count : 0);
+	};
+
+	uint64_t positionCount(void) const
+	{
+		return (m_header ? m_header->index_count : 0);
+	};
+
+	const GameDbRecord &game(uint64_t index) const
+	{
+		return (m_games[index]);
+	};
+
+	const char *string(uint32_t offset) const
+	{
+		return (m_strings + offset);
+	};
+
+	CompactMove move(uint64_t index, int ply) const
+	{
+		uint16_t raw;
+
+		raw = m_moves[m_games[index].first_move + ply];
+		return (CompactMove(raw & 63, (raw >> 6) & 63, raw >> 12));
+	};
+
+	const GameDbEntry *find(uint64_t, uint64_t *) const;
+};
+
+#endif
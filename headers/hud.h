@@ -0,0 +1,43 @@
+#ifndef HUD_H_
+#define HUD_H_
+
+#include "compositor.h"
+#include <vector>
+
+/**
+ * Hud - Optional overlay listing the latency percentiles and counters of
+ * metrics, drawn with a built-in 5x7 pixel font onto the HUD layer
+ *
+ * @m_renderer: Renderer the HUD is drawn with
+ * @m_compositor: Compositor owning the HUD layer
+ * @m_visible: Whether or not the HUD is shown
+ * @m_drawn: Whether or not the HUD layer holds anything to clear
+ * @m_pixels: Lit font pixels of the text, filled in one call
+ */
+class Hud {
+private:
+	SDL_Renderer *m_renderer;
+	Compositor *m_compositor;
+	bool m_visible;
+	bool m_drawn;
+	std::vector<SDL_Rect> m_pixels;
+
+	void text(int, int, const char *);
+
+public:
+	Hud(SDL_Renderer *, Compositor *);
+
+	void toggle(void)
+	{
+		m_visible = !m_visible;
+	};
+
+	bool isVisible(void) const
+	{
+		return (m_visible);
+	};
+
+	void draw(const SDL_Rect *);
+};
+
+#endif
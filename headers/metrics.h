@@ -0,0 +1,107 @@
+#ifndef METRICS_H_
+#define METRICS_H_
+
+#include <chrono>
+#include <stdint.h>
+
+/*
+ * enum Metric - Operations whose latency is recorded
+ */
+enum Metric
+{
+	EVENT_METRIC, HIGHLIGHT_METRIC, MOVE_METRIC, DRAW_METRIC, METRIC_COUNT
+};
+
+// 16 buckets per power of two keep every percentile within 1/16 of the truth
+const int HISTOGRAM_SUB_BUCKETS = 16;
+const int HISTOGRAM_BUCKETS = 512;
+
+/**
+ * LatencyHistogram - Log-linear histogram of durations in microseconds,
+ * fixed size so recording never allocates
+ *
+ * @m_buckets: Number of samples in each bucket
+ * @m_count: Number of samples
+ * @m_total: Sum of the samples
+ * @m_max: Largest sample
+ */
+class LatencyHistogram {
+private:
+	uint64_t m_buckets[HISTOGRAM_BUCKETS];
+	uint64_t m_count;
+	uint64_t m_total;
+	uint64_t m_max;
+
+	static int bucketOf(uint64_t);
+	static uint64_t bucketValue(int);
+
+public:
+	LatencyHistogram(void);
+
+	void record(uint64_t);
+	uint64_t percentile(double) const;
+
+	uint64_t count(void) const
+	{
+		return (m_count);
+	};
+
+	uint64_t mean(void) const
+	{
+		return (m_count ? m_total / m_count : 0);
+	};
+
+	uint64_t max(void) const
+	{
+		return (m_max);
+	};
+};
+
+/**
+ * Metrics - Latency histograms and counters of the running game, only
+ * touched by the UI thread
+ *
+ * @histograms: One histogram per Metric
+ * @frames: Frames presented
+ * @textures: Textures created
+ */
+struct Metrics
+{
+	LatencyHistogram histograms[METRIC_COUNT];
+	uint64_t frames;
+	uint64_t textures;
+};
+
+extern Metrics metrics;
+
+const char *metricName(int);
+bool dumpMetrics(const char *);
+
+/**
+ * LatencyTimer - Records the time between its creation and its destruction
+ * into a histogram of metrics, so every return path of a function is timed
+ *
+ * @m_metric: Metric to record into
+ * @m_start: Instant the timer was created
+ */
+class LatencyTimer {
+private:
+	Metric m_metric;
+	std::chrono::steady_clock::time_point m_start;
+
+public:
+	LatencyTimer(Metric metric)
+	{
+		m_metric = metric;
+		m_start = std::chrono::steady_clock::now();
+	};
+
+	~LatencyTimer(void)
+	{
+		metrics.histograms[m_metric].record(
+				std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - m_start).count());
+	};
+};
+
+#endif
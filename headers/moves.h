@@ -1,61 +1,163 @@
 #ifndef MOVES_H_
 #define MOVES_H_
 
+#include <stdint.h>
+
 enum PieceType
 {
 	KING, QUEEN, ROOK, BISHOP, KNIGHT, PAWN, NONE
 };
 
+/*
+ * enum MoveFlag - The four flag bits of a CompactMove
+ *
+ * Description: Bit 2 marks captures and bit 3 promotions, the low two bits
+ * of a promotion select the piece (knight, bishop, rook, queen)
+ */
+enum MoveFlag
+{
+	QUIET_MOVE, DOUBLE_PUSH, KING_SIDE_CASTLE, QUEEN_SIDE_CASTLE,
+	CAPTURE_MOVE, EN_PASSANT,
+	KNIGHT_PROMOTION = 8, BISHOP_PROMOTION, ROOK_PROMOTION, QUEEN_PROMOTION,
+	KNIGHT_PROMOTION_CAPTURE, BISHOP_PROMOTION_CAPTURE,
+	ROOK_PROMOTION_CAPTURE, QUEEN_PROMOTION_CAPTURE
+};
+
 /**
- * Move - Defines a move made by a player
+ * CompactMove - A move packed into 16 bits, six bits for each of the origin
+ * and destination grids (y * 8 + x) and four MoveFlag bits
+ *
+ * @m_data: The packed move, zero for the null move
  *
- * @from_x: initial x position of piece
- * @to_x: x position to move piece to
- * @from_y: initial y position of piece
- * @to_y: y position of piece to move to
- * @piece_type: Piece type
+ * Description: The default constructor leaves the move uninitialized so a
+ * MoveList costs nothing to create; use CompactMove(0, 0, QUIET_MOVE) for
+ * the null move
  */
-class Move {
+class CompactMove {
 private:
-	int from_x, to_x, from_y, to_y;
-	PieceType piece_type;
+	uint16_t m_data;
 
 public:
-	Move();
+	CompactMove() = default;
+	CompactMove(int from, int to, int flags)
+		: m_data((uint16_t) (from | (to << 6) | (flags << 12))) {};
+
+	int from(void) const
+	{
+		return (m_data & 63);
+	};
+
+	int to(void) const
+	{
+		return ((m_data >> 6) & 63);
+	};
+
+	int flags(void) const
+	{
+		return (m_data >> 12);
+	};
+
+	bool isCapture(void) const
+	{
+		return ((flags() & CAPTURE_MOVE) != 0);
+	};
+
+	bool isPromotion(void) const
+	{
+		return ((flags() & KNIGHT_PROMOTION) != 0);
+	};
 
-	int fromX(void) const
+	bool isCastling(void) const
 	{
-		return (from_x);
+		return (flags() == KING_SIDE_CASTLE || flags() == QUEEN_SIDE_CASTLE);
 	};
 
-	int fromY(void) const
+	PieceType promotion(void) const
 	{
-		return (from_y);
+		static const PieceType promoted[4] = { KNIGHT, BISHOP, ROOK, QUEEN };
+
+		return (isPromotion() ? promoted[flags() & 3] : NONE);
 	};
 
-	int toX(void) const
+	bool isNull(void) const
 	{
-		return (to_x);
+		return (m_data == 0);
 	};
 
-	int toY(void) const
+	uint16_t raw(void) const
 	{
-		return (to_y);
+		return (m_data);
 	};
 
-	PieceType getPieceType(void) const
+	bool operator==(const CompactMove &other) const
 	{
-		return (piece_type);
+		return (m_data == other.m_data);
 	};
 
-	void setFromX(int);
-	void setFromY(int);
-	void setToX(int);
-	void setToY(int);
+	bool operator!=(const CompactMove &other) const
+	{
+		return (m_data != other.m_data);
+	};
+};
+
+const int MAX_MOVES = 256;
+
+/**
+ * MoveList - Fixed capacity list of moves meant to live on the stack, no
+ * position has more than MAX_MOVES legal moves
+ *
+ * @m_moves: Storage for the moves
+ * @m_size: Number of moves in the list
+ */
+class MoveList {
+private:
+	CompactMove m_moves[MAX_MOVES];
+	int m_size;
+
+public:
+	MoveList() : m_size(0) {};
+
+	void add(CompactMove move)
+	{
+		m_moves[m_size++] = move;
+	};
+
+	void clear(void)
+	{
+		m_size = 0;
+	};
+
+	int size(void) const
+	{
+		return (m_size);
+	};
+
+	CompactMove &operator[](int i)
+	{
+		return (m_moves[i]);
+	};
+
+	CompactMove operator[](int i) const
+	{
+		return (m_moves[i]);
+	};
+
+	const CompactMove *begin(void) const
+	{
+		return (m_moves);
+	};
+
+	const CompactMove *end(void) const
+	{
+		return (m_moves + m_size);
+	};
 
-	void setPieceType(PieceType pt)
+	bool contains(CompactMove move) const
 	{
-		this->piece_type = pt;
+		for (int i = 0; i < m_size; i++)
+			if (m_moves[i] == move)
+				return (true);
+		return (false);
 	};
 };
 
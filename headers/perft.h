@@ -0,0 +1,34 @@
+#ifndef PERFT_H_
+#define PERFT_H_
+
+#include "position.h"
+#include <atomic>
+#include <stddef.h>
+
+/**
+ * PerftTable - Lock-free cache of subtree node counts keyed by position hash
+ * and depth, shared by every perft thread
+ *
+ * @m_slots: Pairs of words, (key ^ data, data), data holding the node count
+ * in its upper 56 bits and the depth in the lower 8. A torn write by two
+ * threads breaks the XOR and is read back as a miss, so no lock is needed
+ * @m_mask: Number of entries minus one, the entry count is a power of two
+ */
+class PerftTable {
+private:
+	std::atomic<uint64_t> *m_slots;
+	size_t m_mask;
+
+public:
+	PerftTable(size_t);
+	~PerftTable(void);
+
+	bool probe(uint64_t, int, uint64_t *) const;
+	void store(uint64_t, int, uint64_t);
+};
+
+uint64_t perft(Position &, int);
+uint64_t perftHashed(Position &, int, PerftTable *);
+uint64_t parallelPerft(const Position &, int, int, PerftTable *, uint64_t *);
+
+#endif
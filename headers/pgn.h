@@ -0,0 +1,123 @@
+#ifndef PGN_H_
+#define PGN_H_
+
+#include "position.h"
+#include <stdio.h>
+
+// Bytes read from the file at a time
+const int PGN_BUFFER_SIZE = 1 << 16;
+
+// Longest tag value kept, null byte included, longer ones are cut short
+const int PGN_TAG_LENGTH = 64;
+
+// Longest movetext token read, longer ones are cut short
+const int PGN_TOKEN_LENGTH = 32;
+
+/**
+ * PgnGame - A game read from a PGN file, in fixed size buffers so reading
+ * one game after another never allocates
+ *
+ * @event: Event tag
+ * @date: Date tag
+ * @white: White tag
+ * @black: Black tag
+ * @result: Result tag, or the result ending the movetext if there is none
+ * @fen: FEN tag, empty when the game starts from the start position
+ * @moves: Moves of the main line, in the order played
+ * @move_count: Number of moves
+ * @error: Whether or not a move could not be read or was illegal, moves
+ * then stops right before it
+ */
+struct PgnGame
+{
+	char event[PGN_TAG_LENGTH];
+	char date[PGN_TAG_LENGTH];
+	char white[PGN_TAG_LENGTH];
+	char black[PGN_TAG_LENGTH];
+	char result[PGN_TAG_LENGTH];
+	char fen[MAX_FEN_LENGTH];
+	CompactMove moves[MAX_GAME_PLY];
+	int move_count;
+	bool error;
+};
+
+/**
+ * PgnReader - Streams games out of a PGN file one at a time, reading it in
+ * PGN_BUFFER_SIZE chunks so memory stays the same whatever the file size.
+ * SAN moves are resolved by playing them on a Position, comments, NAGs and
+ * variations are skipped
+ *
+ * @m_file: File read from, owned by the caller
+ * @m_buffer: Chunk of the file being read
+ * @m_pos: Offset of the next character in m_buffer
+ * @m_end: Number of characters in m_buffer
+ * @m_line_start: Whether or not the next character of the movetext starts a
+ * line, where '%' escapes the rest of it
+ * @m_board: Position the moves of the current game are played on
+ * @m_bytes: Bytes read so far
+ * @m_games: Games read so far
+ * @m_moves: Moves read so far
+ * @m_errors: Games read so far that had an unreadable or illegal move
+ */
+class PgnReader {
+private:
+	FILE *m_file;
+	char m_buffer[PGN_BUFFER_SIZE];
+	int m_pos;
+	int m_end;
+	bool m_line_start;
+	Position m_board;
+	uint64_t m_bytes;
+	uint64_t m_games;
+	uint64_t m_moves;
+	uint64_t m_errors;
+
+	bool fill(void);
+
+	int peek(void)
+	{
+		if (m_pos == m_end && !fill())
+			return (EOF);
+		return ((unsigned char) m_buffer[m_pos]);
+	};
+
+	int get(void)
+	{
+		if (m_pos == m_end && !fill())
+			return (EOF);
+		return ((unsigned char) m_buffer[m_pos++]);
+	};
+
+	void skipUntil(int);
+	void skipVariation(void);
+	void readTag(PgnGame &);
+	int readToken(char *, int);
+	void playToken(PgnGame &, const char *, int);
+
+public:
+	PgnReader(FILE *);
+
+	bool next(PgnGame &);
+
+	uint64_t bytes(void) const
+	{
+		return (m_bytes);
+	};
+
+	uint64_t games(void) const
+	{
+		return (m_games);
+	};
+
+	uint64_t moves(void) const
+	{
+		return (m_moves);
+	};
+
+	uint64_t errors(void) const
+	{
+		return (m_errors);
+	};
+};
+
+#endif
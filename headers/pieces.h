@@ -14,7 +14,7 @@ class ChessBoard;
  * @isBlack: Is piece black or not
  * @x: x position of piece
  * @y: y position of piece
- * @pieceTexture: Texture representation of piece to be loaded from image
+ * @sprite: Sprite of the TextureAtlas drawn for the piece
  *
  * Description: Base class declaration for all pieces
  */
@@ -24,12 +24,11 @@ class Piece {
 		int x;
 		int y;
 		PieceType piece_type;
-		SDL_Texture* piece_texture;
+		int sprite;
 		ChessBoard* m_board;
 
 	public:
-		Piece(int, int, bool, SDL_Renderer*, ChessBoard*);
-		~Piece();
+		Piece(int, int, bool, ChessBoard*);
 
 		virtual bool canMove(int, int, Piece* p = nullptr) = 0;
 
@@ -70,9 +69,9 @@ class Piece {
 			return (piece_type);
 		};
 
-		SDL_Texture* getTexture(void) const
+		int getSprite(void) const
 		{
-			return (piece_texture);
+			return (sprite);
 		};
 };
 
@@ -83,7 +82,7 @@ class King : public Piece {
 		bool m_on_check;
 		Piece* m_attacker;
 	public:
-		King(int, int, bool, SDL_Renderer*, ChessBoard*);
+		King(int, int, bool, ChessBoard*);
 		bool canMove(int, int, Piece* p = nullptr) override;
 
 		void setAttacker(Piece* piece)
@@ -123,7 +122,7 @@ class Queen : public Piece {
 		std::vector<Grid> m_intercept;
 		std::vector<Grid> interceptGrids(Piece*, Piece*);
 	public:
-		Queen(int, int, bool, SDL_Renderer*, ChessBoard*);
+		Queen(int, int, bool, ChessBoard*);
 		bool canMove(int, int, Piece* p = nullptr) override;
 		
 		std::vector<Grid> getIntercepts(void) const
@@ -145,7 +144,7 @@ class Rook : public Piece {
 		Grid m_intercept;
 		Grid interceptGrid(Piece*, Piece*);
 	public:
-		Rook(int, int, bool, SDL_Renderer*, ChessBoard*);
+		Rook(int, int, bool, ChessBoard*);
 		bool canMove(int, int, Piece* p = nullptr) override;
 		
 		void moved(void)
@@ -176,7 +175,7 @@ class Bishop : public Piece {
 		std::vector<Grid> m_intercept;
 		std::vector<Grid> interceptGrids(Piece*, Piece*);
 	public:
-		Bishop(int, int, bool, SDL_Renderer*, ChessBoard*);
+		Bishop(int, int, bool, ChessBoard*);
 		bool canMove(int, int, Piece* p = nullptr) override;
 		
 		std::vector<Grid> getIntercepts(void) const
@@ -197,7 +196,7 @@ class Knight : public Piece {
 		std::vector<Grid> m_intercept;
 		std::vector<Grid> interceptGrids(Piece*, Piece*);
 	public:
-		Knight(int, int, bool, SDL_Renderer*, ChessBoard*);
+		Knight(int, int, bool, ChessBoard*);
 		bool canMove(int, int, Piece* p = nullptr) override;
 		std::vector<Grid> getIntercepts(void) const
 		{
@@ -217,7 +216,7 @@ class Pawn : public Piece {
 		Grid m_intercept;
 		Grid interceptGrid(Piece*, Piece*);
 	public:
-		Pawn(int, int, bool, SDL_Renderer*, ChessBoard*);
+		Pawn(int, int, bool, ChessBoard*);
 		bool canMove(int, int, Piece* p = nullptr) override;
 		bool hasMoved(void) const;
 
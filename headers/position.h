@@ -0,0 +1,240 @@
+#ifndef POSITION_H_
+#define POSITION_H_
+
+#include "bitboard.h"
+#include "moves.h"
+#include <vector>
+
+/*
+ * enum CastlingRight - Bits of Position::m_castling. King side castling
+ * brings the king to x = 1 with the rook from x = 0, queen side castling
+ * brings it to x = 5 with the rook from x = 7
+ */
+enum CastlingRight
+{
+	WHITE_KING_SIDE = 1, WHITE_QUEEN_SIDE = 2,
+	BLACK_KING_SIDE = 4, BLACK_QUEEN_SIDE = 8, ALL_CASTLING = 15
+};
+
+// Undo records a Position starts with, the stack grows past them
+const int MAX_GAME_PLY = 1024;
+
+// Longest FEN getFen writes, terminating null byte included
+const int MAX_FEN_LENGTH = 128;
+
+/*
+ * enum DrawState - Rule a game is drawn by, if any
+ */
+enum DrawState
+{
+	NO_DRAW, REPETITION_DRAW, FIFTY_MOVE_DRAW
+};
+
+/**
+ * UndoRecord - The state makeMove overwrites and unmakeMove restores
+ *
+ * @move: Move that was played
+ * @captured: Piece code of the captured piece, NONE if nothing was taken
+ * @castling: Castling rights before the move
+ * @ep_square: En passant grid before the move
+ * @halfmove_clock: Halfmove clock before the move
+ * @key: Zobrist key before the move
+ */
+struct UndoRecord
+{
+	CompactMove move;
+	uint8_t captured;
+	uint8_t castling;
+	int8_t ep_square;
+	uint16_t halfmove_clock;
+	uint64_t key;
+};
+
+/**
+ * Position - Bitboard representation of the pieces on the board, kept in
+ * sync with ChessBoard::m_board so rule queries never touch a Piece object
+ *
+ * @m_pieces: Occupancy of each piece type, indexed by [is_black][PieceType]
+ * @m_colors: Occupancy of all white ([0]) and all black ([1]) pieces
+ * @m_occupied: Occupancy of every piece on the board
+ * @m_mailbox: Piece code of each grid, NONE when the grid is empty
+ * @m_black_turn: Whether or not it is black's turn
+ * @m_castling: CastlingRight bits still available to both sides
+ * @m_ep_square: Grid a pawn may capture en passant on, NO_SQUARE if none
+ * @m_halfmove_clock: Plies since the last capture or pawn move
+ * @m_fullmove: Number of the move being played, counted from 1 and raised
+ * after every black move
+ * @m_key: Zobrist key of the position, updated along with every change so
+ * it always equals computeKey()
+ * @m_undo: Undo stack, one record per move made, which is also the
+ * contiguous move history of the game. It starts with MAX_GAME_PLY records
+ * and doubles whenever a game outgrows it, so no move is ever dropped
+ * @m_undo_size: Number of records on m_undo
+ */
+class Position {
+private:
+	Bitboard m_pieces[2][6];
+	Bitboard m_colors[2];
+	Bitboard m_occupied;
+	uint8_t m_mailbox[64];
+	bool m_black_turn;
+	uint8_t m_castling;
+	int m_ep_square;
+	int m_halfmove_clock;
+	int m_fullmove;
+	uint64_t m_key;
+	std::vector<UndoRecord> m_undo;
+	int m_undo_size;
+
+	void addPawnMoves(MoveList &, int, int, int) const;
+	void addCastling(MoveList &, int) const;
+
+public:
+	Position(void);
+	void clear(void);
+
+	void putPiece(int, PieceType, bool);
+	void removePiece(int);
+	void movePiece(int, int);
+
+	void flipTurn(void);
+
+	bool blackTurn(void) const
+	{
+		return (m_black_turn);
+	};
+
+	int castlingRights(void) const
+	{
+		return (m_castling);
+	};
+
+	void setCastlingRights(int);
+	void updateCastlingRights(int, int);
+
+	int enPassantSquare(void) const
+	{
+		return (m_ep_square);
+	};
+
+	void setEnPassantSquare(int);
+
+	int halfmoveClock(void) const
+	{
+		return (m_halfmove_clock);
+	};
+
+	void setHalfmoveClock(int clock)
+	{
+		m_halfmove_clock = clock;
+	};
+
+	int fullmoveNumber(void) const
+	{
+		return (m_fullmove);
+	};
+
+	int undoSize(void) const
+	{
+		return (m_undo_size);
+	};
+
+	void clearUndo(void)
+	{
+		m_undo_size = 0;
+	};
+
+	const UndoRecord &history(int ply) const
+	{
+		return (m_undo[ply]);
+	};
+
+	CompactMove lastMove(void) const
+	{
+		return (m_undo_size ? m_undo[m_undo_size - 1].move :
+				CompactMove(0, 0, QUIET_MOVE));
+	};
+
+	void trimHistory(int);
+	bool isRepetition(int) const;
+	bool isFiftyMoveDraw(void) const;
+	DrawState drawState(void) const;
+
+	CompactMove encodeMove(int, int, PieceType promotion = QUEEN) const;
+	CompactMove parseSan(const char *, int) const;
+	void makeMove(CompactMove);
+	void unmakeMove(void);
+	bool leavesKingInCheck(CompactMove);
+
+	uint64_t key(void) const
+	{
+		return (m_key);
+	};
+
+	uint64_t computeKey(void) const;
+
+	bool keyIsValid(void) const
+	{
+		return (m_key == computeKey());
+	};
+
+	bool setFen(const char *);
+	int getFen(char *) const;
+
+	PieceType pieceType(int sq) const
+	{
+		return ((PieceType) (m_mailbox[sq] & 7));
+	};
+
+	bool isBlack(int sq) const
+	{
+		return ((m_mailbox[sq] >> 3) != 0);
+	};
+
+	bool isEmpty(int sq) const
+	{
+		return (m_mailbox[sq] == NONE);
+	};
+
+	Bitboard pieces(bool black, PieceType type) const
+	{
+		return (m_pieces[black][type]);
+	};
+
+	Bitboard pieces(bool black) const
+	{
+		return (m_colors[black]);
+	};
+
+	Bitboard occupied(void) const
+	{
+		return (m_occupied);
+	};
+
+	int kingSquare(bool black) const
+	{
+		return (m_pieces[black][KING] ? lsb(m_pieces[black][KING]) : NO_SQUARE);
+	};
+
+	Bitboard attackersTo(int, Bitboard) const;
+	bool isAttacked(int, bool, Bitboard) const;
+
+	bool isAttacked(int sq, bool by_black) const
+	{
+		return (isAttacked(sq, by_black, m_occupied));
+	};
+
+	int firstBlocker(int, int) const;
+	Bitboard checkers(void) const;
+	Bitboard pinnedPieces(bool) const;
+
+	void generateLegalMoves(MoveList &) const;
+};
+
+const char *const START_FEN =
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+void squareName(int, char *);
+void moveName(CompactMove, char *);
+
+#endif
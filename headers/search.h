@@ -0,0 +1,175 @@
+#ifndef SEARCH_H_
+#define SEARCH_H_
+
+#include "position.h"
+#include "transposition.h"
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+const int MAX_PLY = 64;
+const int INFINITE_SCORE = 32001;
+const int MATE_SCORE = 32000;
+// Scores beyond this are mates, the distance to mate being MATE_SCORE - score
+const int MATE_BOUND = MATE_SCORE - MAX_PLY;
+
+/**
+ * struct SearchLimits - When a search should stop, 0 meaning no limit. The
+ * search always completes depth 1 so there is a move to play
+ *
+ * @depth: Deepest iteration to run
+ * @nodes: Nodes to visit
+ * @movetime: Wall-clock budget in milliseconds
+ */
+struct SearchLimits
+{
+	int depth;
+	uint64_t nodes;
+	int movetime;
+};
+
+/**
+ * struct SearchResult - Outcome of the deepest completed iteration
+ *
+ * @best_move: Move to play, null when the side to move has none
+ * @score: Score in centipawns relative to the side to move
+ * @depth: Depth of the deepest completed iteration, 0 if none completed
+ * @nodes: Nodes visited so far, quiescence nodes included
+ * @seconds: Time spent so far
+ * @nps: Nodes visited per second
+ * @pv: Principal variation, starting with best_move
+ * @pv_length: Number of moves in pv
+ */
+struct SearchResult
+{
+	CompactMove best_move;
+	int score;
+	int depth;
+	uint64_t nodes;
+	double seconds;
+	uint64_t nps;
+	CompactMove pv[MAX_PLY];
+	int pv_length;
+};
+
+// Called after every completed iteration with the result so far
+typedef void (*SearchReport)(const SearchResult *, void *);
+
+int evaluate(const Position &);
+
+/**
+ * Search - Iterative deepening negamax alpha-beta searcher. Its position is
+ * a private copy, so the caller's board is never touched
+ *
+ * @m_pos: Position being searched
+ * @m_table: Transposition table, may be shared with other searchers
+ * @m_limits: Limits of the running search
+ * @m_start: Instant the running search started
+ * @m_stop: Raised by stop() or by the limits to abort the search
+ * @m_nodes: Nodes visited by the running search, only written by the
+ * searching thread but readable from any other
+ * @m_first_depth: Depth iterative deepening starts from
+ * @m_killers: Two quiet moves per ply that last caused a beta cutoff
+ * @m_history: Cutoff counts of quiet moves, [is_black][from][to]
+ * @m_pv: Triangular table of the principal variation of each ply
+ * @m_pv_length: End of the principal variation of each ply
+ * @m_report: Iteration callback, may be nullptr
+ * @m_report_data: Passed back to m_report
+ */
+class Search {
+private:
+	Position m_pos;
+	TranspositionTable *m_table;
+	SearchLimits m_limits;
+	std::chrono::steady_clock::time_point m_start;
+	std::atomic<bool> m_stop;
+	std::atomic<uint64_t> m_nodes;
+	int m_first_depth;
+	CompactMove m_killers[MAX_PLY][2];
+	int m_history[2][64][64];
+	CompactMove m_pv[MAX_PLY][MAX_PLY];
+	int m_pv_length[MAX_PLY];
+	SearchReport m_report;
+	void *m_report_data;
+
+	double elapsedSeconds(void) const;
+	void countNode(void);
+	bool limitReached(void);
+	void scoreMoves(const MoveList &, int *, CompactMove, int) const;
+	int negamax(int, int, int, int);
+	int quiescence(int, int, int);
+	SearchResult iterate(const Position &, const SearchLimits &);
+
+	friend class LazySmp;
+
+public:
+	Search(TranspositionTable *);
+
+	void setReport(SearchReport report, void *data)
+	{
+		m_report = report;
+		m_report_data = data;
+	};
+
+	void stop(void)
+	{
+		m_stop = true;
+	};
+
+	void setFirstDepth(int depth)
+	{
+		m_first_depth = depth;
+	};
+
+	uint64_t nodes(void) const
+	{
+		return (m_nodes.load(std::memory_order_relaxed));
+	};
+
+	SearchResult run(const Position &, const SearchLimits &);
+};
+
+/**
+ * LazySmp - Runs one Search per thread on the same root, all sharing one
+ * transposition table. The helpers have no limits of their own and half of
+ * them start a ply deeper than the main search, so the threads spread over
+ * different depths and feed each other cutoffs through the table. The main
+ * search decides when everyone stops
+ *
+ * @m_table: Transposition table shared by every thread
+ * @m_searches: One searcher per thread, the main one first
+ * @m_report: Iteration callback of the main search, may be nullptr
+ * @m_report_data: Passed back to m_report
+ */
+class LazySmp {
+private:
+	TranspositionTable *m_table;
+	std::vector<Search *> m_searches;
+	SearchReport m_report;
+	void *m_report_data;
+
+	static void mainReport(const SearchResult *, void *);
+
+public:
+	LazySmp(TranspositionTable *, int);
+	~LazySmp(void);
+
+	void setThreads(int);
+
+	int threads(void) const
+	{
+		return ((int) m_searches.size());
+	};
+
+	void setReport(SearchReport report, void *data)
+	{
+		m_report = report;
+		m_report_data = data;
+	};
+
+	void stop(void);
+	uint64_t nodes(void) const;
+	SearchResult run(const Position &, const SearchLimits &);
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef SPRITE_BATCH_H_
+#define SPRITE_BATCH_H_
+
+#include "view.h"
+
+const int MAX_BATCH_SPRITES = 256;
+
+/**
+ * SpriteBatch - Collects textured quads cut from the TextureAtlas into one
+ * vertex buffer and submits them with a single SDL_RenderGeometry call,
+ * instead of one SDL_RenderCopy per sprite
+ *
+ * @m_renderer: Renderer the batch is submitted to
+ * @m_atlas: Atlas every sprite comes from
+ * @m_vertices: Four vertices per queued sprite
+ * @m_indices: Two triangles per queued sprite, filled once
+ * @m_count: Number of queued sprites
+ */
+class SpriteBatch {
+private:
+	SDL_Renderer *m_renderer;
+	const TextureAtlas *m_atlas;
+	SDL_Vertex m_vertices[MAX_BATCH_SPRITES * 4];
+	int m_indices[MAX_BATCH_SPRITES * 6];
+	int m_count;
+
+public:
+	SpriteBatch(SDL_Renderer *, const TextureAtlas *);
+
+	void add(int, const SDL_Rect *);
+	void flush(void);
+
+	int size(void) const
+	{
+		return (m_count);
+	};
+};
+
+#endif
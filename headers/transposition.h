@@ -0,0 +1,118 @@
+#ifndef TRANSPOSITION_H_
+#define TRANSPOSITION_H_
+
+#include "moves.h"
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * enum Bound - How a stored score relates to the true score of a position:
+ * an upper bound (the search failed low), a lower bound (it failed high) or
+ * the exact score
+ */
+enum Bound
+{
+	BOUND_NONE, BOUND_UPPER, BOUND_LOWER, BOUND_EXACT
+};
+
+/*
+ * enum ReplacePolicy - Which entry of a full bucket a store overwrites.
+ * DEPTH_PREFERRED keeps deep results from the current search and evicts the
+ * shallowest or oldest entry, ALWAYS_REPLACE evicts the oldest entry and
+ * lets any store overwrite the same position regardless of depth
+ */
+enum ReplacePolicy
+{
+	DEPTH_PREFERRED, ALWAYS_REPLACE
+};
+
+/**
+ * struct TTHit - Decoded transposition table entry
+ *
+ * @move: Best move found in the position, null if none
+ * @score: Score of the position, relative to the side to move
+ * @depth: Depth the position was searched to
+ * @bound: How score relates to the true score
+ */
+struct TTHit
+{
+	CompactMove move;
+	int score;
+	int depth;
+	Bound bound;
+};
+
+const int TT_BUCKET_SIZE = 4;
+
+/**
+ * struct TTEntry - One 16 byte entry. data packs the move in bits 0-15, the
+ * score in 16-31, the depth in 32-39, the bound in 40-41 and the search
+ * generation in 42-47. check holds key ^ data, so an entry torn by two
+ * threads writing at once fails validation and reads back as a miss
+ *
+ * @check: Zobrist key XORed with data
+ * @data: Packed entry
+ */
+struct TTEntry
+{
+	std::atomic<uint64_t> check;
+	std::atomic<uint64_t> data;
+};
+
+/**
+ * struct TTBucket - Entries sharing an index, filling one cache line
+ *
+ * @entries: The entries of the bucket
+ */
+struct alignas(64) TTBucket
+{
+	TTEntry entries[TT_BUCKET_SIZE];
+};
+
+/**
+ * TranspositionTable - Lock-free cache of search results shared by every
+ * search thread
+ *
+ * @m_buckets: Cache line aligned buckets
+ * @m_mask: Number of buckets minus one, the bucket count is a power of two
+ * @m_megabytes: Size the table was last given
+ * @m_generation: Age of the current search, bumped by newSearch
+ * @m_policy: How full buckets are replaced into
+ */
+class TranspositionTable {
+private:
+	TTBucket *m_buckets;
+	size_t m_mask;
+	size_t m_megabytes;
+	uint8_t m_generation;
+	ReplacePolicy m_policy;
+
+public:
+	TranspositionTable(size_t, ReplacePolicy policy = DEPTH_PREFERRED);
+	~TranspositionTable(void);
+
+	void resize(size_t);
+	void clear(void);
+
+	void newSearch(void)
+	{
+		m_generation = (m_generation + 1) & 63;
+	};
+
+	void setPolicy(ReplacePolicy policy)
+	{
+		m_policy = policy;
+	};
+
+	size_t megabytes(void) const
+	{
+		return (m_megabytes);
+	};
+
+	bool probe(uint64_t, TTHit *) const;
+	void store(uint64_t, CompactMove, int, int, Bound);
+	int hashfull(void) const;
+};
+
+#endif
@@ -3,10 +3,87 @@
 
 #include <SDL2/SDL.h>
 
+/*
+ * enum Sprite - Images packed into the TextureAtlas. The piece sprites of
+ * each color follow PieceType order, the knights having a second sprite
+ * facing the other way
+ */
+enum Sprite
+{
+	WHITE_KING_SPRITE, WHITE_QUEEN_SPRITE, WHITE_ROOK_SPRITE,
+	WHITE_BISHOP_SPRITE, WHITE_KNIGHT_SPRITE, WHITE_PAWN_SPRITE,
+	BLACK_KING_SPRITE, BLACK_QUEEN_SPRITE, BLACK_ROOK_SPRITE,
+	BLACK_BISHOP_SPRITE, BLACK_KNIGHT_SPRITE, BLACK_PAWN_SPRITE,
+	WHITE_KNIGHT2_SPRITE, BLACK_KNIGHT2_SPRITE,
+	ACTIVE_BLACK_SPRITE, ACTIVE_WHITE_SPRITE, MOVE_SPRITE, CAPTURE_SPRITE,
+	CASTLING_SPRITE, SPRITE_COUNT
+};
+
+/**
+ * TextureAtlas - Every piece and overlay image packed into one texture,
+ * decoded once when the atlas is created, so drawing never switches
+ * textures and pieces only need to know their Sprite. The images are kept
+ * so the texture can be rebuilt with every sprite pre-scaled to the size it
+ * is drawn at, sparing the renderer a scaled copy per sprite
+ *
+ * @m_renderer: Renderer the texture is created for
+ * @m_images: Decoded image of each sprite, nullptr if it failed to load
+ * @m_texture: The packed texture, nullptr if it could not be built
+ * @m_rects: Area of each sprite within m_texture
+ * @m_width: Width of m_texture
+ * @m_height: Height of m_texture
+ * @m_sprite_size: Side of every sprite in m_texture, 0 for their own sizes
+ */
+class TextureAtlas {
+private:
+	SDL_Renderer *m_renderer;
+	SDL_Surface *m_images[SPRITE_COUNT];
+	SDL_Texture *m_texture;
+	SDL_Rect m_rects[SPRITE_COUNT];
+	int m_width;
+	int m_height;
+	int m_sprite_size;
+
+public:
+	TextureAtlas(SDL_Renderer *);
+	~TextureAtlas(void);
+
+	bool build(int);
+
+	int getSpriteSize(void) const
+	{
+		return (m_sprite_size);
+	};
+
+	SDL_Texture *getTexture(void) const
+	{
+		return (m_texture);
+	};
+
+	const SDL_Rect *getRect(int sprite) const
+	{
+		return (&m_rects[sprite]);
+	};
+
+	int getWidth(void) const
+	{
+		return (m_width);
+	};
+
+	int getHeight(void) const
+	{
+		return (m_height);
+	};
+
+	void draw(SDL_Renderer *, int, const SDL_Rect *) const;
+};
+
 bool init(void);
+bool initHeadless(void);
 void wrapUp(void);
 SDL_Window* createWindow(const char*, int, int, int, int, unsigned int);
 SDL_Texture* loadImage(const char*, SDL_Renderer*);
 SDL_Renderer* createRenderer(SDL_Window*, unsigned int);
+SDL_Renderer* createOffscreenRenderer(SDL_Surface**, int, int);
 
 #endif
@@ -0,0 +1,19 @@
+#ifndef ZOBRIST_H_
+#define ZOBRIST_H_
+
+#include <stdint.h>
+
+/*
+ * Random keys XORed together to form the 64-bit Zobrist hash of a position:
+ * one per piece on each grid, one per castling rights combination, one per
+ * en passant file and one for black to move. They are drawn from a fixed
+ * seed so keys stay stable across runs and builds
+ */
+extern uint64_t zobrist_pieces[2][6][64];
+extern uint64_t zobrist_castling[16];
+extern uint64_t zobrist_ep[8];
+extern uint64_t zobrist_black;
+
+void initZobrist(void);
+
+#endif
@@ -1,7 +1,66 @@
 #include "headers/game.h"
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
 
 int main(int argc, char* args[])
 {
-	start();
+	const char* fen_path;
+	const char* out_dir;
+	const char* metrics_path;
+	const char* fen;
+	const char* pgn_path;
+	int movetime, repeat, animation_time, game_number;
+
+	// "-headless [-o dir] [-n repeat] [fen file]" renders positions without
+	// a display, saving PNG snapshots to dir and timing repeat renders each
+	if (argc > 1 && strcmp(args[1], "-headless") == 0)
+	{
+		fen_path = nullptr;
+		out_dir = nullptr;
+		repeat = 1;
+		for (int i = 2; i < argc; i++)
+		{
+			if (strcmp(args[i], "-o") == 0 && i + 1 < argc)
+				out_dir = args[++i];
+			else if (strcmp(args[i], "-n") == 0 && i + 1 < argc)
+				repeat = atoi(args[++i]);
+			else
+				fen_path = args[i];
+		}
+		headless(fen_path, out_dir, repeat > 0 ? repeat : 1);
+		return (0);
+	}
+
+	// "-e [ms]" lets the engine play black, thinking ms per move,
+	// "-m file" writes the latency metrics to file as CSV on exit and
+	// "-d ms" sets how long moves take to animate, 0 to turn it off and
+	// "-f fen" starts the game from the position fen and "-p file [-g n]"
+	// loads game n of a PGN file, the first by default, to step through
+	// with the arrow keys
+	movetime = 0;
+	metrics_path = nullptr;
+	fen = nullptr;
+	pgn_path = nullptr;
+	game_number = 1;
+	animation_time = 150;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(args[i], "-e") == 0)
+			movetime = i + 1 < argc && isdigit(args[i + 1][0]) ?
+				atoi(args[++i]) : 1000;
+		else if (strcmp(args[i], "-m") == 0 && i + 1 < argc)
+			metrics_path = args[++i];
+		else if (strcmp(args[i], "-d") == 0 && i + 1 < argc)
+			animation_time = atoi(args[++i]);
+		else if (strcmp(args[i], "-f") == 0 && i + 1 < argc)
+			fen = args[++i];
+		else if (strcmp(args[i], "-p") == 0 && i + 1 < argc)
+			pgn_path = args[++i];
+		else if (strcmp(args[i], "-g") == 0 && i + 1 < argc)
+			game_number = atoi(args[++i]);
+	}
+	start(movetime, metrics_path, animation_time, fen, pgn_path,
+			game_number);
 	return (0);
 }
@@ -3,19 +3,16 @@
 
 #define PI 3.14159265358979323846
 
-Bishop::Bishop(int x, int y, bool isBlack, SDL_Renderer* renderer,
-		ChessBoard* board)
-	: Piece(x, y, isBlack, renderer, board)
+Bishop::Bishop(int x, int y, bool isBlack, ChessBoard* board)
+	: Piece(x, y, isBlack, board)
 {
 	piece_type = PieceType::BISHOP;
 	if (isBlack)
 	{
-		piece_texture = loadImage("assets/black_bishop.png",
-				renderer);
+		sprite = BLACK_BISHOP_SPRITE;
 	} else
 	{
-		piece_texture = loadImage("assets/white_bishop.png",
-				renderer);
+		sprite = WHITE_BISHOP_SPRITE;
 	}
 }
 
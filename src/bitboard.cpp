@@ -0,0 +1,114 @@
+#include "../headers/bitboard.h"
+
+Bitboard knight_attacks[64];
+Bitboard king_attacks[64];
+Bitboard pawn_attacks[2][64];
+Bitboard ray_attacks[8][64];
+Bitboard between_bits[64][64];
+Bitboard line_bits[64][64];
+
+// x and y increments for each Direction, in enum order
+static const int dir_x[8] = { 0, 1, 1, -1, 0, -1, -1, 1 };
+static const int dir_y[8] = { 1, 0, 1, 1, -1, 0, -1, -1 };
+
+/**
+ * offsetBit - Returns the bit of the grid (x + dx, y + dy) if it lies on the
+ * board
+ *
+ * @x: x position of the origin grid
+ * @y: y position of the origin grid
+ * @dx: x-axis offset
+ * @dy: y-axis offset
+ *
+ * Return: Bitboard with the single target grid set, or 0 if it is off board
+ */
+static Bitboard offsetBit(int x, int y, int dx, int dy)
+{
+	x += dx;
+	y += dy;
+	if (x < 0 || x > 7 || y < 0 || y > 7)
+		return (0);
+	return (squareBit(square(x, y)));
+}
+
+/**
+ * buildTables - Fills every attack table, see initAttackTables
+ *
+ * Return: Always true
+ */
+static bool buildTables(void)
+{
+	for (int sq = 0; sq < 64; sq++)
+	{
+		int x, y;
+
+		x = squareX(sq);
+		y = squareY(sq);
+
+		knight_attacks[sq] = offsetBit(x, y, 1, 2) | offsetBit(x, y, -1, 2) |
+			offsetBit(x, y, 1, -2) | offsetBit(x, y, -1, -2) |
+			offsetBit(x, y, 2, 1) | offsetBit(x, y, 2, -1) |
+			offsetBit(x, y, -2, 1) | offsetBit(x, y, -2, -1);
+
+		king_attacks[sq] = 0;
+		for (int dir = 0; dir < 8; dir++)
+			king_attacks[sq] |= offsetBit(x, y, dir_x[dir], dir_y[dir]);
+
+		// White pawns advance up the board (y + 1), black pawns down
+		pawn_attacks[0][sq] = offsetBit(x, y, 1, 1) | offsetBit(x, y, -1, 1);
+		pawn_attacks[1][sq] = offsetBit(x, y, 1, -1) | offsetBit(x, y, -1, -1);
+
+		for (int dir = 0; dir < 8; dir++)
+		{
+			Bitboard ray;
+
+			ray = 0;
+			for (int step = 1; step < 8; step++)
+			{
+				Bitboard bit;
+
+				bit = offsetBit(x, y, dir_x[dir] * step, dir_y[dir] * step);
+				if (!bit)
+					break;
+				ray |= bit;
+			}
+			ray_attacks[dir][sq] = ray;
+		}
+	}
+
+	for (int a = 0; a < 64; a++)
+	{
+		for (int b = 0; b < 64; b++)
+		{
+			between_bits[a][b] = 0;
+			line_bits[a][b] = 0;
+			for (int dir = 0; dir < 8; dir++)
+			{
+				if (ray_attacks[dir][a] & squareBit(b))
+				{
+					// (dir + 4) % 8 is the opposite direction
+					between_bits[a][b] = ray_attacks[dir][a] &
+						~ray_attacks[dir][b] & ~squareBit(b);
+					line_bits[a][b] = ray_attacks[dir][a] |
+						ray_attacks[(dir + 4) % 8][a] | squareBit(a);
+					break;
+				}
+			}
+		}
+	}
+	return (true);
+}
+
+/**
+ * initAttackTables - Precomputes the knight, king, pawn, ray, between and
+ * line tables the bitboard attack lookups read from. Safe to call any number
+ * of times and from any thread, the tables are only built once
+ *
+ * Return: Nothing
+ */
+void initAttackTables(void)
+{
+	static const bool built = buildTables();
+
+	(void) built;
+}
@@ -30,35 +30,30 @@ std::ostream& operator<<(std::ostream& os, const Piece& piece) {
  */
 bool ChessBoard::isSafe(Piece *piece, int x_scout, int y_scout)
 {
-	std::vector<Piece*> foes;
-
-	foes = piece->isBlack() ? getWhitePieces() : getBlackPieces();
 	if (m_board[x_scout][y_scout])
 		return (false);
-	for (Piece* p : foes)
-	{
-		PieceType p_type;
-
-		p_type = p->getPieceType();
-
-		if (p_type == PAWN)
-		{
-			// Handles pawn piece peculiar case: Pawns can't capture on all the squares
-			// they can move to, So a custom implementation is required
+	return (!isExposed(piece, x_scout, y_scout));
+}
 
-			if (abs(x_scout - p->getX()) == 1 && abs(y_scout - p->getY()) == 1)
-				return (false);
-		} else if (p_type == KING)
-		{
-			// Handles king piece, using the king's canMove function will result in an
-			// unending loop
+/**
+ * isExposed - Checks if a piece stepping onto a grid would stand attacked
+ * there
+ *
+ * @piece: Piece stepping
+ * @x: x-axis position of the grid
+ * @y: y-axis position of the grid
+ *
+ * Return: true if an opponent attacks the grid, false Otherwise
+ */
+bool ChessBoard::isExposed(Piece *piece, int x, int y)
+{
+	Bitboard occupied;
 
-			if (abs(x_scout - p->getX()) <= 1 && abs(y_scout - p->getY()) <= 1)
-				return (false);
-		} else if (p->canMove(x_scout, y_scout, piece))
-			return (false);
-	}
-	return (true);
+	// The piece is lifted off the board so sliding pieces see through it,
+	// a king stepping back along the line of attack is not safe
+	occupied = m_position.occupied() &
+		~squareBit(square(piece->getX(), piece->getY()));
+	return (m_position.isAttacked(square(x, y), !piece->isBlack(), occupied));
 }
 
 /**
@@ -71,47 +66,25 @@ bool ChessBoard::isSafe(Piece *piece, int x_scout, int y_scout)
  */
 void ChessBoard::check(Piece *ignore)
 {
-	int king_x, king_y;
-
-	if (m_black_turn)
-	{
-		king_x = m_black_king->getX();
-		king_y = m_black_king->getY();
+	Bitboard attackers;
+	King* king;
+	int attacker;
 
-		for (Piece* p : m_white_pieces)
-		{
-			if (p->getPieceType() != KING &&
-					p != ignore &&
-					p->canMove(king_x, king_y))
-			{
-				m_black_king->setCheck(true);
-				m_black_king->setAttacker(p);
-				return;
-			}
-		}
+	king = m_black_turn ? m_black_king : m_white_king;
+	attackers = m_position.checkers();
+	if (ignore)
+		attackers &= ~squareBit(square(ignore->getX(), ignore->getY()));
 
-		m_black_king->setCheck(false);
-		m_black_king->setAttacker(nullptr);
-	} else
+	if (attackers)
 	{
-		king_x = m_white_king->getX();
-		king_y = m_white_king->getY();
-
-		for (Piece* p : m_black_pieces)
-		{
-			if (p->getPieceType() != KING &&
-					p != ignore &&
-					p->canMove(king_x, king_y))
-			{
-				m_white_king->setCheck(true);
-				m_white_king->setAttacker(p);
-				return;
-			}
-		}
-
-		m_white_king->setCheck(false);
-		m_white_king->setAttacker(nullptr);
+		attacker = lsb(attackers);
+		king->setCheck(true);
+		king->setAttacker(m_board[squareX(attacker)][squareY(attacker)]);
+		return;
 	}
+
+	king->setCheck(false);
+	king->setAttacker(nullptr);
 }
 
 /**
@@ -151,21 +124,30 @@ King* ChessBoard::pieceKing(Piece *piece)
  */
 bool ChessBoard::isPiecePinned(Piece *piece)
 {
-	int piece_x, piece_y;
-	bool pinned;
-	King* king;
-
 	if (!piece || piece->getPieceType() == KING)
 		return (false);
+	return ((m_position.pinnedPieces(piece->isBlack()) &
+				squareBit(square(piece->getX(), piece->getY()))) != 0);
+}
 
-	piece_x = piece->getX();
-	piece_y = piece->getY();
-
-	m_board[piece_x][piece_y] = nullptr;
-	check();
-	pinned = underCheck(piece);
-	m_board[piece_x][piece_y] = piece;
-	check();
+/**
+ * moveCatastrophy - Checks if moving a piece to the grid (x, y) would leave
+ * its own king under check. The move is played on m_position and taken back,
+ * m_board is left untouched
+ *
+ * @piece: Piece to move
+ * @x: x-axis destination
+ * @y: y-axis destination
+ *
+ * Return: true if the move exposes the king, false otherwise
+ */
+bool ChessBoard::moveCatastrophy(Piece *piece, int x, int y)
+{
+	CompactMove move;
 
-	return (pinned);
+	if (!piece || !isPieceTurn(piece))
+		return (true);
+	move = m_position.encodeMove(square(piece->getX(), piece->getY()),
+			square(x, y));
+	return (m_position.leavesKingInCheck(move));
 }
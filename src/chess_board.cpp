@@ -1,9 +1,20 @@
 #include "../headers/game.h"
 #include "../headers/pieces.h"
+#include "../headers/metrics.h"
 #include <cmath>
+#include <stdlib.h>
 
-ChessBoard::ChessBoard(SDL_Renderer* renderer, const int board_size)
+/**
+ * ChessBoard - Creates the board, laid out to fill the renderer output
+ *
+ * @renderer: Renderer the board is drawn with
+ *
+ * Return: Nothing
+ */
+ChessBoard::ChessBoard(SDL_Renderer* renderer)
 {
+	int width, height;
+
 	m_black_turn = false;
 	m_renderer = renderer;
 	if (!m_renderer)
@@ -20,20 +31,85 @@ ChessBoard::ChessBoard(SDL_Renderer* renderer, const int board_size)
 		// Throw Exception
 	}
 
-	m_board_size = board_size;
+	m_atlas = new TextureAtlas(m_renderer);
+
+	// The layers cover the whole window, board and side strip alike, in
+	// pixels rather than window points on HiDPI displays
+	if (SDL_GetRendererOutputSize(m_renderer, &width, &height) != 0)
+	{
+		width = SCREEN_WIDTH;
+		height = SCREEN_HEIGHT;
+	}
+	m_compositor = new Compositor(m_renderer, width, height);
+	m_batch = new SpriteBatch(m_renderer, m_atlas);
+	m_hud = new Hud(m_renderer, m_compositor);
+	m_legal_valid = false;
+	m_draw = NO_DRAW;
+	m_background_drawn = false;
+	m_animation_count = 0;
+	m_animation_start = 0;
+	m_animation_time = 0;
+	for (int x = 0; x < 8; x++)
+	{
+		for (int y = 0; y < 8; y++)
+		{
+			m_overlays[x][y] = -1;
+			m_drawn_pieces[x][y] = -2;
+			m_drawn_overlays[x][y] = -2;
+		}
+	}
+
+	layout(width, height);
+	initBoard();
+}
+
+/**
+ * layout - Sizes the board to a window and pre-scales the sprites to the
+ * grids. The board takes the height of the window and at most three quarters
+ * of its width, the HUD strip gets the rest
+ *
+ * @width: Width of the window in pixels
+ * @height: Height of the window in pixels
+ *
+ * Return: Nothing
+ */
+void ChessBoard::layout(int width, int height)
+{
+	m_board_size = height < width * 3 / 4 ? height : width * 3 / 4;
 
 	// Border padding constitues roughly 3.125% (each side) of board image,
 	// Use simple calculation to remove it
-	m_board_pad = ceil (board_size * 3.125) / 100;
+	m_board_pad = ceil (m_board_size * 3.125) / 100;
 
 	// Obtain the size of each grid
-	m_grid_size = floor((board_size - m_board_pad * 2) / 8);
-	m_last_move = new Move();
-	initBoard();
+	m_grid_size = floor((m_board_size - m_board_pad * 2) / 8);
+
+	// Inset of the sprites within their grid, 5 pixels on a 600 pixel board
+	m_sprite_inset = m_grid_size / 14;
+	m_atlas->build(m_grid_size - m_sprite_inset);
 }
 
 /**
- * init_board - Initializes m_board with the pieces
+ * resize - Lays the board out again for a new window size, the next render
+ * redraws every layer
+ *
+ * @width: Width of the window in pixels
+ * @height: Height of the window in pixels
+ *
+ * Return: Nothing
+ */
+void ChessBoard::resize(int width, int height)
+{
+	if (width == m_compositor->getWidth() &&
+			height == m_compositor->getHeight())
+		return;
+	m_compositor->resize(width, height);
+	layout(width, height);
+	invalidate();
+}
+
+/**
+ * init_board - Initializes m_board with the pieces of the starting position
  *
  * Return: Void function returns nothing
  */
@@ -43,148 +119,421 @@ void ChessBoard::initBoard(void)
 	for (int x = 0; x < 8; x++)
 		for (int y = 0; y < 8; y++)
 			m_board[x][y] = nullptr;
+	setFen(START_FEN);
+}
 
-	// Initialization of the white pieces in the board
-	m_board[0][0] = new Rook(0, 0, false, m_renderer, this);
-	m_board[7][0] = new Rook(7, 0, false, m_renderer, this);
+/**
+ * newPiece - Creates a piece of this board
+ *
+ * @type: Type of the piece
+ * @x: x-axis position of the piece
+ * @y: y-axis position of the piece
+ * @black: Whether or not the piece is black
+ *
+ * Return: The new piece, owned by the caller until placed on m_board
+ */
+Piece* ChessBoard::newPiece(PieceType type, int x, int y, bool black)
+{
+	switch (type)
+	{
+		case KING:
+			return (new King(x, y, black, this));
+		case QUEEN:
+			return (new Queen(x, y, black, this));
+		case ROOK:
+			return (new Rook(x, y, black, this));
+		case BISHOP:
+			return (new Bishop(x, y, black, this));
+		case KNIGHT:
+			return (new Knight(x, y, black, this));
+		default:
+			return (new Pawn(x, y, black, this));
+	}
+}
 
-	m_board[1][0] = new Knight(1, 0, false, m_renderer, this);
-	m_board[6][0] = new Knight(6, 0, false, m_renderer, this);
+/**
+ * clearPieces - Deletes every piece on the board
+ *
+ * Return: Nothing
+ */
+void ChessBoard::clearPieces(void)
+{
+	for (int x = 0; x < 8; x++)
+	{
+		for (int y = 0; y < 8; y++)
+		{
+			if (m_board[x][y] != nullptr)
+			{
+				delete (m_board[x][y]);
+				m_board[x][y] = nullptr;
+			}
+		}
+	}
+	m_black_pieces.clear();
+	m_white_pieces.clear();
+	m_black_king = nullptr;
+	m_white_king = nullptr;
+}
 
-	m_board[2][0] = new Bishop(2, 0, false, m_renderer, this);
-	m_board[5][0] = new Bishop(5, 0, false, m_renderer, this);
+/**
+ * setFen - Sets the board up from a FEN string, replacing every piece. The
+ * string is parsed in place by Position::setFen. Kings and rooks that may
+ * still castle are left unmoved, every other one is marked as moved. The
+ * en passant grid and the clocks are taken over as they are
+ *
+ * @fen: FEN string to set up
+ *
+ * Return: true on success, false if fen is invalid, in which case the board
+ * is left untouched
+ */
+bool ChessBoard::setFen(const char* fen)
+{
+	Position pos;
 
-	m_board[3][0] = new King(3, 0, false, m_renderer, this);
-	m_board[4][0] = new Queen(4, 0, false, m_renderer, this);
+	if (!pos.setFen(fen))
+		return (false);
 
-	// Keeping a reference to the white king to be used for checks
-	m_white_king = dynamic_cast<King*>(m_board[3][0]);
+	clearPieces();
+	for (int sq = 0; sq < 64; sq++)
+	{
+		Piece* piece;
+
+		if (pos.isEmpty(sq))
+			continue;
+		piece = newPiece(pos.pieceType(sq), squareX(sq), squareY(sq),
+				pos.isBlack(sq));
+		m_board[squareX(sq)][squareY(sq)] = piece;
+		if (piece->isBlack())
+			m_black_pieces.push_back(piece);
+		else
+			m_white_pieces.push_back(piece);
+
+		// Keeping a reference to the kings to be used for checks
+		if (piece->getPieceType() == KING)
+		{
+			if (piece->isBlack())
+				m_black_king = dynamic_cast<King*>(piece);
+			else
+				m_white_king = dynamic_cast<King*>(piece);
+		}
+	}
 
-	m_white_pieces.push_back(m_board[0][0]);
-	m_white_pieces.push_back(m_board[7][0]);
-	m_white_pieces.push_back(m_board[1][0]);
-	m_white_pieces.push_back(m_board[6][0]);
-	m_white_pieces.push_back(m_board[2][0]);
-	m_white_pieces.push_back(m_board[5][0]);
-	m_white_pieces.push_back(m_board[3][0]);
-	m_white_pieces.push_back(m_board[4][0]);
+	// Castling rights become the moved flags of the kings and rooks, the
+	// position already dropped the rights of pieces away from home
+	for (int black = 0; black < 2; black++)
+	{
+		std::vector<Piece*>* pieces;
+		int rights, y;
 
-	// Initialization of the black pieces in the board
-	m_board[0][7] = new Rook(0, 7, true, m_renderer, this);
-	m_board[7][7] = new Rook(7, 7, true, m_renderer, this);
+		rights = pos.castlingRights() >> (black ? 2 : 0);
+		y = black ? 7 : 0;
+		pieces = black ? &m_black_pieces : &m_white_pieces;
+		for (int i = 0; i < pieces->size(); i++)
+		{
+			Piece* piece;
+
+			piece = (*pieces)[i];
+			if (piece->getPieceType() == KING && !(rights &
+						(WHITE_KING_SIDE | WHITE_QUEEN_SIDE)))
+				dynamic_cast<King*>(piece)->moved();
+			else if (piece->getPieceType() == ROOK &&
+					!(piece->getX() == 0 && piece->getY() == y &&
+						(rights & WHITE_KING_SIDE)) &&
+					!(piece->getX() == 7 && piece->getY() == y &&
+						(rights & WHITE_QUEEN_SIDE)))
+				dynamic_cast<Rook*>(piece)->moved();
+		}
+	}
 
-	m_board[1][7] = new Knight(1, 7, true, m_renderer, this);
-	m_board[6][7] = new Knight(6, 7, true, m_renderer, this);
+	m_position = pos;
+	m_black_turn = pos.blackTurn();
+	m_legal_valid = false;
+	m_draw = NO_DRAW;
+	m_animation_count = 0;
+	check(nullptr);
+	return (true);
+}
 
-	m_board[2][7] = new Bishop(2, 7, true, m_renderer, this);
-	m_board[5][7] = new Bishop(5, 7, true, m_renderer, this);
+/**
+ * getFen - Writes the FEN string of the board
+ *
+ * @out: Buffer of at least MAX_FEN_LENGTH characters
+ *
+ * Return: Length of the FEN written, null byte excluded
+ */
+int ChessBoard::getFen(char* out) const
+{
+	return (m_position.getFen(out));
+}
 
-	m_board[3][7] = new King(3, 7, true, m_renderer, this);
-	m_board[4][7] = new Queen(4, 7, true, m_renderer, this);
+/**
+ * drawBoard - Drops every highlight and renders the board
+ *
+ * Return: Nothing
+ */
+void ChessBoard::drawBoard(void)
+{
+	clearHighlights();
+	render();
+}
 
-	// Keeping a reference to the black king to be used for checks
-	m_black_king = dynamic_cast<King*>(m_board[3][7]);
+/**
+ * clearHighlights - Drops every highlight, the grids they covered are
+ * re-rendered by the next render call
+ *
+ * Return: Nothing
+ */
+void ChessBoard::clearHighlights(void)
+{
+	for (int x = 0; x < 8; x++)
+		for (int y = 0; y < 8; y++)
+			m_overlays[x][y] = -1;
+}
+
+/**
+ * gridRect - Computes the area of a grid on the window
+ *
+ * @x: x position of the grid
+ * @y: y position of the grid
+ * @offset: Inset from the top left corner, used to fit the sprites
+ *
+ * Return: The area of the grid
+ */
+SDL_Rect ChessBoard::gridRect(int x, int y, int offset) const
+{
+	SDL_Rect rect;
 
-	m_black_pieces.push_back(m_board[0][7]);
-	m_black_pieces.push_back(m_board[7][7]);
-	m_black_pieces.push_back(m_board[1][7]);
-	m_black_pieces.push_back(m_board[6][7]);
-	m_black_pieces.push_back(m_board[2][7]);
-	m_black_pieces.push_back(m_board[5][7]);
-	m_black_pieces.push_back(m_board[3][7]);
-	m_black_pieces.push_back(m_board[4][7]);
+	rect.x = (int) floor(x * m_grid_size + m_board_pad) + offset;
+	rect.y = (int) floor(y * m_grid_size + m_board_pad) + offset;
+	rect.w = m_grid_size - offset;
+	rect.h = m_grid_size - offset;
+	return (rect);
+}
+
+/**
+ * renderLayer - Re-renders the grids of a layer whose sprite changed, all
+ * cleared in one call and all redrawn in one batch
+ *
+ * @layer: Layer to update
+ * @wanted: Sprite each grid should show, -1 for none
+ * @drawn: Sprite each grid shows now, updated to wanted
+ *
+ * Return: Nothing
+ */
+void ChessBoard::renderLayer(Layer layer, int wanted[8][8], int drawn[8][8])
+{
+	SDL_Rect dirty[64];
+	int count;
 
-	// Loop to add pawns to the board
-	for (int i = 0; i < 8; i++)
+	count = 0;
+	for (int x = 0; x < 8; x++)
 	{
-		m_board[i][1] = new Pawn(i, 1, false, m_renderer, this);
-		m_white_pieces.push_back(m_board[i][1]);
+		for (int y = 0; y < 8; y++)
+		{
+			SDL_Rect square;
 
-		m_board[i][6] = new Pawn(i, 6, true, m_renderer, this);
-		m_black_pieces.push_back(m_board[i][6]);
+			if (wanted[x][y] == drawn[x][y])
+				continue;
+			dirty[count++] = gridRect(x, y, 0);
+			if (wanted[x][y] >= 0)
+			{
+				square = gridRect(x, y, m_sprite_inset);
+				m_batch->add(wanted[x][y], &square);
+			}
+			drawn[x][y] = wanted[x][y];
+		}
 	}
+	if (count == 0)
+		return;
+	m_compositor->begin(layer);
+	m_compositor->clearRects(dirty, count);
+	m_batch->flush();
 }
 
 /**
- * drawBoard - Draws every piece in m_board on the board
+ * renderFrame - Brings the layers up to date with the pieces given and the
+ * highlights, re-rendering only the grids whose sprite changed since the last
+ * frame, then shows the frame with a single present
+ *
+ * @pieces: Piece sprite wanted on each grid, -1 for none
  *
  * Return: Nothing
  */
-void ChessBoard::drawBoard(void)
+void ChessBoard::renderFrame(int pieces[8][8])
 {
-	// Offset used to adjust piece size and position in grid
-	int p_offset;
+	LatencyTimer timer(DRAW_METRIC);
+	SDL_Rect strip;
 
-	p_offset = 5;
+	if (!m_background_drawn)
+	{
+		// Define the position and size the board should be drawn using a
+		// rectangle
+		const SDL_Rect fillRect = { 0, 0, m_board_size, m_board_size };
+
+		m_compositor->begin(BACKGROUND_LAYER);
+		m_compositor->clear();
+		SDL_RenderCopy(m_renderer, m_chess_board, nullptr, &fillRect);
+		m_background_drawn = true;
+	}
 
-	// Clear window renderer
-	SDL_RenderClear(m_renderer);
+	renderLayer(HIGHLIGHT_LAYER, m_overlays, m_drawn_overlays);
+	renderLayer(PIECE_LAYER, pieces, m_drawn_pieces);
+	strip = { m_board_size, 0, m_compositor->getWidth() - m_board_size,
+		m_compositor->getHeight() };
+	m_hud->draw(&strip);
+	m_compositor->compose();
+	drawAnimations();
+	m_compositor->present();
+}
 
-	// Define the position and size the board should be drawn using a rectangle
-	const SDL_Rect fillRect = { 0, 0, m_board_size, m_board_size };
+/**
+ * render - Renders m_board and the highlights
+ *
+ * Return: Nothing
+ */
+void ChessBoard::render(void)
+{
+	int pieces[8][8];
 
-	// Draws chess board onto the window so pieces can be drawn onto the board
-	SDL_RenderCopy(m_renderer, m_chess_board, nullptr, &fillRect);
+	if (m_animation_count > 0 &&
+			SDL_GetTicks() - m_animation_start >= (Uint32) m_animation_time)
+		m_animation_count = 0;
+	for (int x = 0; x < 8; x++)
+		for (int y = 0; y < 8; y++)
+			pieces[x][y] = m_board[x][y] ? m_board[x][y]->getSprite() : -1;
 
-	// SDL_RenderPresent(m_renderer); Uncomment this and board starts to flicker
+	// A gliding piece is drawn above the layers until it lands
+	for (int i = 0; i < m_animation_count; i++)
+		pieces[m_animations[i].to_x][m_animations[i].to_y] = -1;
+	renderFrame(pieces);
+}
 
-	// Set the render target to the chess board
-	SDL_SetRenderTarget(m_renderer, m_chess_board);
+/**
+ * renderPosition - Renders the pieces of a position instead of m_board,
+ * without highlights, for diagrams of positions that were never played on
+ * this board
+ *
+ * @pos: Position to render
+ *
+ * Return: Nothing
+ */
+void ChessBoard::renderPosition(const Position& pos)
+{
+	int pieces[8][8];
 
-	for (int x = 0; x < 8; x++)
+	clearHighlights();
+	for (int sq = 0; sq < 64; sq++)
 	{
-		for (int y = 0; y < 8; y++)
-		{
-			SDL_Rect piece_square;
-			float xpos, ypos;
+		// Sprites of each color follow PieceType order
+		if (pos.isEmpty(sq))
+			pieces[squareX(sq)][squareY(sq)] = -1;
+		else
+			pieces[squareX(sq)][squareY(sq)] = pos.pieceType(sq) +
+				(pos.isBlack(sq) ? BLACK_KING_SPRITE : WHITE_KING_SPRITE);
+	}
+	renderFrame(pieces);
+}
 
-			if (m_board[x][y] == nullptr)
-				continue;
-			xpos = floor(x * m_grid_size + m_board_pad) + p_offset;
-			ypos = floor(y * m_grid_size + m_board_pad) + p_offset;
-			piece_square = {(int) xpos, (int) ypos,
-				m_grid_size - p_offset,
-				m_grid_size - p_offset };
-			SDL_RenderCopy(m_renderer, m_board[x][y]->getTexture(),
-					NULL, &piece_square);
+/**
+ * animateLastMove - Starts gliding the piece of the last move in the game
+ * history, and the rook when it castled, from its old grid to its new one.
+ * movePiece must already have been called
+ *
+ * Return: Nothing
+ */
+void ChessBoard::animateLastMove(void)
+{
+	Animation* anim;
+	Piece* piece;
+	CompactMove last;
+	int from_x, from_y, to_x, to_y;
+
+	m_animation_count = 0;
+	last = m_position.lastMove();
+	if (m_animation_time <= 0 || last.isNull())
+		return;
+	from_x = squareX(last.from());
+	from_y = squareY(last.from());
+	to_x = squareX(last.to());
+	to_y = squareY(last.to());
+	piece = m_board[to_x][to_y];
+	if (piece == nullptr)
+		return;
+
+	anim = &m_animations[m_animation_count++];
+	*anim = { piece->getSprite(), from_x, from_y, to_x, to_y };
+	if (piece->getPieceType() == KING && abs(to_x - from_x) == 2)
+	{
+		// King side castling brings the rook from x = 0 to 2, queen side
+		// from x = 7 to 4
+		piece = m_board[to_x == 1 ? 2 : 4][to_y];
+		if (piece)
+		{
+			anim = &m_animations[m_animation_count++];
+			*anim = { piece->getSprite(), to_x == 1 ? 0 : 7, to_y,
+				to_x == 1 ? 2 : 4, to_y };
 		}
 	}
-
-	SDL_RenderPresent(m_renderer);
-	SDL_SetRenderTarget(m_renderer, nullptr);
+	m_animation_start = SDL_GetTicks();
 }
 
 /**
- * setLastMove - Sets m_last_move to the last move played
+ * drawAnimations - Draws the gliding pieces onto the window at their
+ * current place, easing in and out of the move
  *
- * @from_x: intial x position of piece before move
- * @to_x: x position of piece after move
- * @from_y: initial y position of piece before move
- * @to_y: y position of piece after move
- * @type: Type of piece that made the last move e.g PAWN
+ * Return: Nothing
  */
-void ChessBoard::setLastMove(int from_x, int to_x, int from_y, int to_y, PieceType type)
+void ChessBoard::drawAnimations(void)
 {
-	m_last_move->setFromX(from_x);
-	m_last_move->setToX(to_x);
-	m_last_move->setFromY(from_y);
-	m_last_move->setToY(to_y);
-	m_last_move->setPieceType(type);
+	float t;
+
+	if (m_animation_count == 0)
+		return;
+	t = (float) (SDL_GetTicks() - m_animation_start) / m_animation_time;
+	t = t > 1.0f ? 1.0f : t;
+	t = t * t * (3.0f - 2.0f * t);
+	for (int i = 0; i < m_animation_count; i++)
+	{
+		SDL_Rect from, to, square;
+
+		from = gridRect(m_animations[i].from_x, m_animations[i].from_y,
+				m_sprite_inset);
+		to = gridRect(m_animations[i].to_x, m_animations[i].to_y,
+				m_sprite_inset);
+		square.x = from.x + (int) ((to.x - from.x) * t);
+		square.y = from.y + (int) ((to.y - from.y) * t);
+		square.w = to.w;
+		square.h = to.h;
+		m_batch->add(m_animations[i].sprite, &square);
+	}
+	m_batch->flush();
 }
 
-ChessBoard::~ChessBoard()
+/**
+ * invalidate - Marks every layer out of date, so the next frame renders
+ * everything again instead of only what changed
+ *
+ * Return: Nothing
+ */
+void ChessBoard::invalidate(void)
 {
+	m_background_drawn = false;
 	for (int x = 0; x < 8; x++)
 	{
 		for (int y = 0; y < 8; y++)
 		{
-			if (m_board[x][y] != nullptr)
-			{
-				delete (m_board[x][y]);
-				m_board[x][y] = nullptr;
-			}
+			m_drawn_pieces[x][y] = -2;
+			m_drawn_overlays[x][y] = -2;
 		}
 	}
-	delete m_last_move;
+}
+
+ChessBoard::~ChessBoard()
+{
+	clearPieces();
+	delete m_hud;
+	delete m_batch;
+	delete m_compositor;
+	delete m_atlas;
 	SDL_DestroyTexture(m_chess_board);
 }
@@ -1,18 +1,98 @@
 #include "../headers/game.h"
 #include "../headers/pieces.h"
+#include "../headers/metrics.h"
+
+/**
+ * updateLegalCache - Fills m_legal from the legal moves of m_position, once
+ * per position however many times it is queried
+ *
+ * Return: Nothing
+ */
+void ChessBoard::updateLegalCache(void)
+{
+	MoveList list;
+
+	if (m_legal_valid)
+		return;
+	for (int sq = 0; sq < 64; sq++)
+	{
+		m_legal[sq] = 0;
+		m_legal_captures[sq] = 0;
+	}
+	m_legal_castles = 0;
+	m_position.generateLegalMoves(list);
+	for (int i = 0; i < list.size(); i++)
+	{
+		CompactMove move = list[i];
+
+		m_legal[move.from()] |= squareBit(move.to());
+		if (move.isCapture())
+			m_legal_captures[move.from()] |= squareBit(move.to());
+		if (move.isCastling())
+			m_legal_castles |= squareBit(move.to());
+	}
+	m_legal_valid = true;
+}
+
+/**
+ * legalTargets - Finds the grids a piece may legally move to
+ *
+ * @piece: Piece to move
+ *
+ * Return: Bitboard of the grids, empty when it is not the piece's turn
+ */
+Bitboard ChessBoard::legalTargets(const Piece* piece)
+{
+	updateLegalCache();
+	return (m_legal[square(piece->getX(), piece->getY())]);
+}
+
+/**
+ * isLegalMove - Checks whether or not a piece may legally move to a grid
+ *
+ * @piece: Piece to move
+ * @x: x position of the grid
+ * @y: y position of the grid
+ *
+ * Return: true if the move is legal, Otherwise false
+ */
+bool ChessBoard::isLegalMove(const Piece* piece, int x, int y)
+{
+	return ((legalTargets(piece) & squareBit(square(x, y))) != 0);
+}
+
+/**
+ * playMove - Plays a legal move of the side to move and hands the turn over,
+ * as a move made by clicking does
+ *
+ * @move: Move to play
+ *
+ * Return: Nothing
+ */
+void ChessBoard::playMove(CompactMove move)
+{
+	movePiece(m_board[squareX(move.from())][squareY(move.from())],
+			squareX(move.to()), squareY(move.to()),
+			move.isPromotion() ? move.promotion() : QUEEN);
+	flipTurn();
+	check(nullptr);
+}
 
 /**
  * movePiece - Updates the position of piece, and m_board with the specified
- * position
+ * position, playing the same move on m_position
  *
  * @piece: Piece object being moved
  * @x: x position to move piece to
  * @y: y position to move piece to
+ * @promotion: Piece a pawn reaching the last rank turns into
  *
  * Return: Nothing
  */
-void ChessBoard::movePiece(Piece* piece, int x, int y)
+void ChessBoard::movePiece(Piece* piece, int x, int y, PieceType promotion)
 {
+	LatencyTimer timer(MOVE_METRIC);
+	CompactMove move;
 	int prevX, prevY;
 	Piece* tmp;
 
@@ -20,6 +100,19 @@ void ChessBoard::movePiece(Piece* piece, int x, int y)
 	prevY = piece->getY();
 	tmp = m_board[x][y];
 
+	m_legal_valid = false;
+	move = m_position.encodeMove(square(prevX, prevY), square(x, y),
+			promotion);
+	m_position.makeMove(move);
+	m_draw = m_position.drawState();
+#ifdef DEBUG_ZOBRIST
+	// Build with -DDEBUG_ZOBRIST to check the incremental key against a
+	// full recompute after every move
+	if (!m_position.keyIsValid())
+		fprintf(stderr, "Zobrist key mismatch after %c%d%c%d\n",
+				'a' + 7 - prevX, prevY + 1, 'a' + 7 - x, y + 1);
+#endif
+
 	m_board[x][y] = piece;
 	piece->setX(x);
 	piece->setY(y);
@@ -92,12 +185,52 @@ void ChessBoard::movePiece(Piece* piece, int x, int y)
 		delete tmp;
 	}
 
-	drawBoard();
+	if (piece->getPieceType() == PAWN && (y == 0 || y == 7))
+		promotePawn(piece, promotion);
+
+	// The caller renders once it has started the move's animation
+	clearHighlights();
 }
 
 /**
- * trackDiagonal - Traverses each every grid diagonally leading to the
- * specified x_dest and y_dest, only advancing if no piece was found in the way
+ * promotePawn - Replaces a pawn that reached the last rank with a new piece,
+ * m_position already promoted it in makeMove
+ *
+ * @pawn: Pawn to promote, deleted by this function
+ * @type: Type of the new piece, a queen unless a rook, bishop or knight
+ *
+ * Return: Nothing
+ */
+void ChessBoard::promotePawn(Piece* pawn, PieceType type)
+{
+	std::vector<Piece*>* pieces;
+	Piece* promoted;
+	int x, y;
+
+	x = pawn->getX();
+	y = pawn->getY();
+	if (type != ROOK && type != BISHOP && type != KNIGHT)
+		type = QUEEN;
+	promoted = newPiece(type, x, y, pawn->isBlack());
+
+	// A promoted rook never gives castling rights
+	if (type == ROOK)
+		dynamic_cast<Rook*>(promoted)->moved();
+	pieces = pawn->isBlack() ? &m_black_pieces : &m_white_pieces;
+	for (int i = 0; i < pieces->size(); i++)
+	{
+		if ((*pieces)[i] == pawn)
+			(*pieces)[i] = promoted;
+	}
+	m_board[x][y] = promoted;
+
+	delete pawn;
+}
+
+/**
+ * trackDiagonal - Finds the first piece standing on the diagonal leading to
+ * the specified x_dest and y_dest, reading the occupancy bitboard instead of
+ * walking m_board grid by grid
  *
  * @piece: Travelling piece
  * @x_dest: x destination of the travelling piece
@@ -107,32 +240,19 @@ void ChessBoard::movePiece(Piece* piece, int x, int y)
  */
 Piece* ChessBoard::trackDiagonal(Piece* piece, int x_dest, int y_dest)
 {
-	Piece* blocker;
-	bool upper, left;
-	int x_r, y_r;
-
-	upper = y_dest < piece->getY();
-	left = x_dest < piece->getX();
+	int blocker;
 
-	x_r = left ? piece->getX() - 1 : piece->getX() + 1;
-	y_r = upper ? piece->getY() - 1 : piece->getY() + 1;
-
-	blocker = nullptr;
-
-	for (; abs(x_r - x_dest) != 0 && abs(y_r - y_dest) != 0;
-			x_r += left ? -1 : 1, y_r += upper ? -1 : 1)
-	{
-		blocker = m_board[x_r][y_r];
-		if (blocker != nullptr)
-			break;
-	}
-	return (blocker);
+	blocker = m_position.firstBlocker(square(piece->getX(), piece->getY()),
+			square(x_dest, y_dest));
+	if (blocker == NO_SQUARE)
+		return (nullptr);
+	return (m_board[squareX(blocker)][squareY(blocker)]);
 }
 
 /**
- * trackStraight - Traverses each and every grid in a straight line leading to
- * the specified x_dest and y_dest, only advancing if no piece was found in the
- * way
+ * trackStraight - Finds the first piece standing on the rank or file leading
+ * to the specified x_dest and y_dest, reading the occupancy bitboard instead
+ * of walking m_board grid by grid
  *
  * @piece: Travelling piece
  * @x_dest: x destination of the travelling piece
@@ -142,38 +262,13 @@ Piece* ChessBoard::trackDiagonal(Piece* piece, int x_dest, int y_dest)
  */
 Piece* ChessBoard::trackStraight(Piece* piece, int x_dest, int y_dest)
 {
-	Piece* blocker;
-
-	blocker = nullptr;
-	if (abs(piece->getX() - x_dest) > 0)
-	{
-		bool left;
-		int x_r;
+	int blocker;
 
-		left = x_dest < piece->getX();
-		x_r = left ? piece->getX() - 1 : piece->getX() + 1;
-		for (; abs(x_r - x_dest) != 0; x_r += left ? -1 : 1)
-		{
-			blocker = m_board[x_r][y_dest];
-			if (blocker != nullptr)
-				break;
-		}
-	} else
-	{
-		bool down;
-		int y_r;
-
-		down = y_dest > piece->getY();
-		y_r = down ? piece->getY() + 1 : piece->getY() - 1;
-		for (; abs(y_r - y_dest) != 0; y_r += down ? 1 : -1)
-		{
-			blocker = m_board[x_dest][y_r];
-			if (blocker != nullptr)
-				break;
-		}
-	}
-
-	return (blocker);
+	blocker = m_position.firstBlocker(square(piece->getX(), piece->getY()),
+			square(x_dest, y_dest));
+	if (blocker == NO_SQUARE)
+		return (nullptr);
+	return (m_board[squareX(blocker)][squareY(blocker)]);
 }
 
 /**
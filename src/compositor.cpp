@@ -0,0 +1,169 @@
+#include "../headers/compositor.h"
+#include "../headers/metrics.h"
+
+/**
+ * Compositor - Creates the layers, all cleared to transparent
+ *
+ * @renderer: Renderer to create the layers for
+ * @width: Width of the layers, usually the renderer output width
+ * @height: Height of the layers
+ *
+ * Return: Nothing
+ */
+Compositor::Compositor(SDL_Renderer* renderer, int width, int height)
+{
+	m_renderer = renderer;
+	for (int i = 0; i < LAYER_COUNT; i++)
+		m_layers[i] = nullptr;
+	m_width = 0;
+	m_height = 0;
+	resize(width, height);
+}
+
+Compositor::~Compositor(void)
+{
+	destroyLayers();
+}
+
+/**
+ * destroyLayers - Frees every layer texture
+ *
+ * Return: Nothing
+ */
+void Compositor::destroyLayers(void)
+{
+	for (int i = 0; i < LAYER_COUNT; i++)
+	{
+		if (m_layers[i])
+			SDL_DestroyTexture(m_layers[i]);
+		m_layers[i] = nullptr;
+	}
+}
+
+/**
+ * resize - Recreates the layers at a new size, their content is lost and
+ * must be rendered again
+ *
+ * @width: New width of the layers
+ * @height: New height of the layers
+ *
+ * Return: true on success, false if a layer could not be created
+ */
+bool Compositor::resize(int width, int height)
+{
+	destroyLayers();
+	m_width = width;
+	m_height = height;
+	for (int i = 0; i < LAYER_COUNT; i++)
+	{
+		m_layers[i] = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_ARGB8888,
+				SDL_TEXTUREACCESS_TARGET, width, height);
+		if (m_layers[i] == nullptr)
+		{
+			SDL_Log("Failed to create layer texture!!!\nError Output: %s\n",
+					SDL_GetError());
+			return (false);
+		}
+		metrics.textures++;
+		SDL_SetTextureBlendMode(m_layers[i], SDL_BLENDMODE_BLEND);
+		begin((Layer) i);
+		clear();
+	}
+	end();
+	return (true);
+}
+
+/**
+ * begin - Directs the following draws to a layer
+ *
+ * @layer: Layer to draw on
+ *
+ * Return: Nothing
+ */
+void Compositor::begin(Layer layer)
+{
+	SDL_SetRenderTarget(m_renderer, m_layers[layer]);
+}
+
+/**
+ * clearRect - Makes an area of the current layer transparent again
+ *
+ * @rect: Area to clear
+ *
+ * Return: Nothing
+ */
+void Compositor::clearRect(const SDL_Rect* rect)
+{
+	SDL_SetRenderDrawBlendMode(m_renderer, SDL_BLENDMODE_NONE);
+	SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 0);
+	SDL_RenderFillRect(m_renderer, rect);
+}
+
+/**
+ * clearRects - Makes several areas of the current layer transparent again
+ * in one call
+ *
+ * @rects: Areas to clear
+ * @count: Number of areas
+ *
+ * Return: Nothing
+ */
+void Compositor::clearRects(const SDL_Rect* rects, int count)
+{
+	if (count == 0)
+		return;
+	SDL_SetRenderDrawBlendMode(m_renderer, SDL_BLENDMODE_NONE);
+	SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 0);
+	SDL_RenderFillRects(m_renderer, rects, count);
+}
+
+/**
+ * clear - Makes the whole current layer transparent again
+ *
+ * Return: Nothing
+ */
+void Compositor::clear(void)
+{
+	SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 0);
+	SDL_RenderClear(m_renderer);
+}
+
+/**
+ * end - Directs the following draws back to the window
+ *
+ * Return: Nothing
+ */
+void Compositor::end(void)
+{
+	SDL_SetRenderTarget(m_renderer, nullptr);
+}
+
+/**
+ * compose - Stacks the layers onto the window, anything drawn afterwards
+ * lands above every layer
+ *
+ * Return: Nothing
+ */
+void Compositor::compose(void)
+{
+	SDL_SetRenderTarget(m_renderer, nullptr);
+	SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 255);
+	SDL_RenderClear(m_renderer);
+	for (int i = 0; i < LAYER_COUNT; i++)
+	{
+		if (m_layers[i])
+			SDL_RenderCopy(m_renderer, m_layers[i], nullptr, nullptr);
+	}
+}
+
+/**
+ * present - Shows the composed frame, waiting for the vertical blank when
+ * the renderer was created with vsync
+ *
+ * Return: Nothing
+ */
+void Compositor::present(void)
+{
+	SDL_RenderPresent(m_renderer);
+	metrics.frames++;
+}
@@ -0,0 +1,180 @@
+#include "../headers/engine_worker.h"
+#include <string.h>
+
+/**
+ * EngineWorker - Registers the worker events and starts its thread, which
+ * sleeps until a request is posted
+ *
+ * @engine: Engine the requests are searched with, owned by the caller
+ *
+ * Return: Nothing
+ */
+EngineWorker::EngineWorker(LazySmp* engine)
+{
+	m_engine = engine;
+	m_latest = 0;
+	m_running = 0;
+	m_quit = false;
+	m_event_base = SDL_RegisterEvents(2);
+	if (m_event_base == (Uint32) -1)
+		SDL_Log("Failed to register engine events!!!\nError Output: %s\n",
+				SDL_GetError());
+	m_engine->setReport(report, this);
+	m_thread = std::thread(&EngineWorker::loop, this);
+}
+
+/**
+ * ~EngineWorker - Stops the running search and waits for the thread to exit
+ *
+ * Return: Nothing
+ */
+EngineWorker::~EngineWorker(void)
+{
+	m_quit = true;
+	cancel();
+	m_thread.join();
+	m_engine->setReport(nullptr, nullptr);
+}
+
+/**
+ * discardQueue - Frees every request still waiting, m_mutex must be held
+ *
+ * Return: Nothing
+ */
+void EngineWorker::discardQueue(void)
+{
+	while (!m_queue.empty())
+	{
+		delete m_queue.front();
+		m_queue.pop_front();
+	}
+}
+
+/**
+ * post - Queues a position for the worker, superseding the running search
+ * and every request still waiting
+ *
+ * @pos: Position to search, copied so the caller may change it right away
+ * @limits: When the search should stop, all 0 to analyse until cancelled
+ *
+ * Return: Id of the request, found in user.code of its events
+ */
+int EngineWorker::post(const Position& pos, const SearchLimits& limits)
+{
+	EngineRequest* request;
+	int id;
+
+	request = new EngineRequest;
+	request->pos = pos;
+	request->limits = limits;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		id = ++m_latest;
+		request->id = id;
+		discardQueue();
+
+		// Stopped before the request is visible, so the stop can only hit
+		// the search being superseded
+		m_engine->stop();
+		m_queue.push_back(request);
+	}
+	m_wake.notify_one();
+	return (id);
+}
+
+/**
+ * cancel - Stops the running search and drops every waiting request, the
+ * results of both are never reported
+ *
+ * Return: Nothing
+ */
+void EngineWorker::cancel(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		++m_latest;
+		discardQueue();
+		m_engine->stop();
+	}
+	m_wake.notify_one();
+}
+
+/**
+ * pushResult - Hands a copy of a result to the UI thread as an SDL event
+ *
+ * @type: Event type, progressEvent() or bestMoveEvent()
+ * @id: Id of the request the result belongs to
+ * @result: Result to send
+ *
+ * Return: Nothing
+ */
+void EngineWorker::pushResult(Uint32 type, int id, const SearchResult& result)
+{
+	SDL_Event event;
+
+	if (m_event_base == (Uint32) -1)
+		return;
+	memset(&event, 0, sizeof(event));
+	event.type = type;
+	event.user.code = id;
+	event.user.data1 = new SearchResult(result);
+	if (SDL_PushEvent(&event) <= 0)
+		delete (SearchResult *) event.user.data1;
+}
+
+/**
+ * report - Iteration callback of the engine, run on the worker thread.
+ * Forwards the progress of the current request and stops a search that was
+ * superseded, in case its stop came before the engine started
+ *
+ * @result: Result of the completed iteration
+ * @data: The EngineWorker
+ *
+ * Return: Nothing
+ */
+void EngineWorker::report(const SearchResult* result, void* data)
+{
+	EngineWorker* worker;
+
+	worker = (EngineWorker *) data;
+	if (worker->m_quit || !worker->isCurrent(worker->m_running))
+		worker->m_engine->stop();
+	else
+		worker->pushResult(worker->progressEvent(), worker->m_running,
+				*result);
+}
+
+/**
+ * loop - Body of the worker thread, searches one request at a time until
+ * the worker quits
+ *
+ * Return: Nothing
+ */
+void EngineWorker::loop(void)
+{
+	EngineRequest* request;
+	SearchResult result;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+
+			m_wake.wait(lock, [this] {
+				return (m_quit || !m_queue.empty());
+			});
+			if (m_quit)
+				return;
+			request = m_queue.front();
+			m_queue.pop_front();
+		}
+
+		m_running = request->id;
+		result = m_engine->run(request->pos, request->limits);
+		if (!m_quit && isCurrent(m_running))
+			pushResult(bestMoveEvent(), m_running, result);
+		delete request;
+	}
+}
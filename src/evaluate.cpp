@@ -0,0 +1,157 @@
+#include "../headers/search.h"
+
+// Material values, indexed by PieceType
+static const int piece_values[6] = { 0, 900, 500, 330, 320, 100 };
+
+/*
+ * Piece-square bonuses from white's side, laid out as printed: rank 8 first,
+ * file a first. Black reads them mirrored vertically
+ */
+static const int piece_square[6][64] = {
+	// KING, middle game
+	{
+		-30, -40, -40, -50, -50, -40, -40, -30,
+		-30, -40, -40, -50, -50, -40, -40, -30,
+		-30, -40, -40, -50, -50, -40, -40, -30,
+		-30, -40, -40, -50, -50, -40, -40, -30,
+		-20, -30, -30, -40, -40, -30, -30, -20,
+		-10, -20, -20, -20, -20, -20, -20, -10,
+		 20,  20,   0,   0,   0,   0,  20,  20,
+		 20,  30,  10,   0,   0,  10,  30,  20
+	},
+	// QUEEN
+	{
+		-20, -10, -10,  -5,  -5, -10, -10, -20,
+		-10,   0,   0,   0,   0,   0,   0, -10,
+		-10,   0,   5,   5,   5,   5,   0, -10,
+		 -5,   0,   5,   5,   5,   5,   0,  -5,
+		  0,   0,   5,   5,   5,   5,   0,  -5,
+		-10,   5,   5,   5,   5,   5,   0, -10,
+		-10,   0,   5,   0,   0,   0,   0, -10,
+		-20, -10, -10,  -5,  -5, -10, -10, -20
+	},
+	// ROOK
+	{
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		  5,  10,  10,  10,  10,  10,  10,   5,
+		 -5,   0,   0,   0,   0,   0,   0,  -5,
+		 -5,   0,   0,   0,   0,   0,   0,  -5,
+		 -5,   0,   0,   0,   0,   0,   0,  -5,
+		 -5,   0,   0,   0,   0,   0,   0,  -5,
+		 -5,   0,   0,   0,   0,   0,   0,  -5,
+		  0,   0,   0,   5,   5,   0,   0,   0
+	},
+	// BISHOP
+	{
+		-20, -10, -10, -10, -10, -10, -10, -20,
+		-10,   0,   0,   0,   0,   0,   0, -10,
+		-10,   0,   5,  10,  10,   5,   0, -10,
+		-10,   5,   5,  10,  10,   5,   5, -10,
+		-10,   0,  10,  10,  10,  10,   0, -10,
+		-10,  10,  10,  10,  10,  10,  10, -10,
+		-10,   5,   0,   0,   0,   0,   5, -10,
+		-20, -10, -10, -10, -10, -10, -10, -20
+	},
+	// KNIGHT
+	{
+		-50, -40, -30, -30, -30, -30, -40, -50,
+		-40, -20,   0,   0,   0,   0, -20, -40,
+		-30,   0,  10,  15,  15,  10,   0, -30,
+		-30,   5,  15,  20,  20,  15,   5, -30,
+		-30,   0,  15,  20,  20,  15,   0, -30,
+		-30,   5,  10,  15,  15,  10,   5, -30,
+		-40, -20,   0,   5,   5,   0, -20, -40,
+		-50, -40, -30, -30, -30, -30, -40, -50
+	},
+	// PAWN
+	{
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		 50,  50,  50,  50,  50,  50,  50,  50,
+		 10,  10,  20,  30,  30,  20,  10,  10,
+		  5,   5,  10,  25,  25,  10,   5,   5,
+		  0,   0,   0,  20,  20,   0,   0,   0,
+		  5,  -5, -10,   0,   0, -10,  -5,   5,
+		  5,  10,  10, -20, -20,  10,  10,   5,
+		  0,   0,   0,   0,   0,   0,   0,   0
+	}
+};
+
+// The king walks to the center once the heavy pieces are gone
+static const int king_endgame[64] = {
+	-50, -40, -30, -20, -20, -30, -40, -50,
+	-30, -20, -10,   0,   0, -10, -20, -30,
+	-30, -10,  20,  30,  30,  20, -10, -30,
+	-30, -10,  30,  40,  40,  30, -10, -30,
+	-30, -10,  30,  40,  40,  30, -10, -30,
+	-30, -10,  20,  30,  30,  20, -10, -30,
+	-30, -30,   0,   0,   0,   0, -30, -30,
+	-50, -30, -30, -30, -30, -30, -30, -50
+};
+
+// Weight of each piece type in the game phase, 24 with every piece on board
+static const int phase_weights[6] = { 0, 4, 2, 1, 1, 0 };
+
+/**
+ * tableIndex - Maps a grid onto the printed layout of the tables
+ *
+ * @sq: Grid of the piece
+ * @black: Whether or not the piece is black
+ *
+ * Return: Index into piece_square
+ */
+static int tableIndex(int sq, bool black)
+{
+	int file, rank;
+
+	file = 7 - squareX(sq);
+	rank = black ? 7 - squareY(sq) : squareY(sq);
+	return ((7 - rank) * 8 + file);
+}
+
+/**
+ * evaluate - Static evaluation from material and piece placement, the king
+ * table fading from the middle game one to the endgame one as pieces leave
+ * the board
+ *
+ * @pos: Position to evaluate
+ *
+ * Return: Score in centipawns relative to the side to move
+ */
+int evaluate(const Position &pos)
+{
+	int score[2], phase, king_mg, king_eg, total;
+
+	phase = 0;
+	king_mg = 0;
+	king_eg = 0;
+	for (int c = 0; c < 2; c++)
+	{
+		int sign, ksq;
+
+		score[c] = 0;
+		for (int t = QUEEN; t <= PAWN; t++)
+		{
+			Bitboard bb;
+
+			bb = pos.pieces(c, (PieceType) t);
+			while (bb)
+			{
+				score[c] += piece_values[t] +
+					piece_square[t][tableIndex(popLsb(bb), c)];
+				phase += phase_weights[t];
+			}
+		}
+		sign = c ? -1 : 1;
+		ksq = pos.kingSquare(c);
+		if (ksq == NO_SQUARE)
+			continue;
+		king_mg += sign * piece_square[KING][tableIndex(ksq, c)];
+		king_eg += sign * king_endgame[tableIndex(ksq, c)];
+	}
+	if (phase > 24)
+		phase = 24;
+
+	total = score[0] - score[1] +
+		(king_mg * phase + king_eg * (24 - phase)) / 24;
+	return (pos.blackTurn() ? -total : total);
+}
@@ -1,59 +1,148 @@
 #include "../headers/game.h"
 #include "../headers/pieces.h"
+#include "../headers/engine_worker.h"
+#include "../headers/metrics.h"
+#include "../headers/pgn.h"
 #include <stdio.h>
 #include <cmath>
+#include <thread>
+
+// Milliseconds per frame while animating without vsync, about 60 per second
+const Uint32 FRAME_TIME = 16;
 
-const int SCREEN_WIDTH = 800;
-const int SCREEN_HEIGHT = 600;
-const int BOARD_SIZE = 600;
 SDL_Window* window;
 SDL_Renderer* window_renderer;
 ChessBoard* board;
 bool quit;
 Piece* active_piece;
+int engine_movetime;
+TranspositionTable* engine_table;
+LazySmp* engine;
+EngineWorker* worker;
+int engine_request;
+bool analysing;
+PgnGame* replay;
+int replay_ply;
+uint64_t replay_key;
 
 /**
  * start - Starts the game handling window initialization and making
  * appropriate call to event handlers
  *
+ * @movetime: Milliseconds the engine thinks per move when it plays black, 0
+ * for a game between two humans
+ * @metrics_path: CSV file the metrics are written to on exit, nullptr for
+ * none
+ * @animation_time: Milliseconds a move takes to animate, 0 for none
+ * @fen: FEN of the position to start from, nullptr for the start position
+ * @pgn_path: PGN file of a game to step through, nullptr for none
+ * @game_number: Number of that game in the file, counted from 1
+ *
  * Return: Nothing
  */
-void start(void)
+void start(int movetime, const char* metrics_path, int animation_time,
+		const char* fen, const char* pgn_path, int game_number)
 {
+	SDL_RendererInfo info;
+	Uint32 frame_start;
+	bool vsync;
+
 	if (init())
 	{
 		// Create window and assign it window variable
 		window = createWindow("Chess", SCREEN_WIDTH, SCREEN_HEIGHT,
 				SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-				SDL_WINDOW_SHOWN);
+				SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE |
+				SDL_WINDOW_ALLOW_HIGHDPI);
 		if (window == nullptr)
 		{
 			printf("window == nullptr\n");
 			return;
 		}
-		// Create window renderer
-		window_renderer = createRenderer(window, SDL_RENDERER_ACCELERATED);
+		// Create window renderer, presenting in step with the display so
+		// animations are paced by vsync
+		window_renderer = createRenderer(window, SDL_RENDERER_ACCELERATED |
+				SDL_RENDERER_PRESENTVSYNC);
 		if (window_renderer == nullptr)
 		{
 			printf("window_renderer == nullptr\n");
 			return;
 		}
-		board = new ChessBoard(window_renderer, BOARD_SIZE);
+		board = new ChessBoard(window_renderer);
+		board->setAnimationTime(animation_time);
+		if (fen && !board->setFen(fen))
+			printf("Invalid FEN, starting from the start position: %s\n",
+					fen);
+		vsync = SDL_GetRendererInfo(window_renderer, &info) == 0 &&
+			(info.flags & SDL_RENDERER_PRESENTVSYNC);
 		active_piece = nullptr;
 		quit = false;
+		engine_movetime = movetime;
+		engine_request = 0;
+		analysing = false;
+
+		// One search thread per core, all behind the worker thread
+		engine_table = new TranspositionTable(64);
+		engine = new LazySmp(engine_table,
+				std::thread::hardware_concurrency() > 0 ?
+				std::thread::hardware_concurrency() : 1);
+		worker = new EngineWorker(engine);
 
+		replay = nullptr;
+		if (pgn_path)
+			loadGame(pgn_path, game_number);
 		board->drawBoard();
+
+		// The engine may be the one to move in the position given
+		if (fen && !replay)
+			afterMove();
 		while (!quit)
 		{
 			SDL_Event event;
 
-			if (SDL_WaitEvent(&event))
+			if (!board->isAnimating())
+			{
+				// Nothing moves, sleep until something happens
+				if (SDL_WaitEvent(&event))
+					eventHandler(&event);
+				continue;
+			}
+			while (SDL_PollEvent(&event))
 				eventHandler(&event);
+			frame_start = SDL_GetTicks();
+			board->render();
+
+			// Without vsync the present returns at once, pace it by hand
+			if (!vsync && SDL_GetTicks() - frame_start < FRAME_TIME)
+				SDL_Delay(FRAME_TIME - (SDL_GetTicks() - frame_start));
 		}
+		delete replay;
+		delete worker;
+		delete engine;
+		delete engine_table;
+		if (metrics_path)
+			dumpMetrics(metrics_path);
 	}
 	wrapUp();
 }
 
+/**
+ * pixelScale - Finds how many renderer pixels a window point spans, more
+ * than 1 on HiDPI displays
+ *
+ * Return: Pixels per window point
+ */
+float pixelScale(void)
+{
+	int window_w, window_h, pixel_w, pixel_h;
+
+	SDL_GetWindowSize(window, &window_w, &window_h);
+	if (window_w <= 0 ||
+			SDL_GetRendererOutputSize(window_renderer, &pixel_w, &pixel_h) != 0)
+		return (1.0f);
+	return ((float) pixel_w / window_w);
+}
+
 /**
  * eventHandler - Handles the game events
  *
@@ -64,19 +153,79 @@ void start(void)
  */
 void eventHandler(SDL_Event* event)
 {
+	LatencyTimer timer(EVENT_METRIC);
+
+	if (event->type == worker->progressEvent() ||
+			event->type == worker->bestMoveEvent())
+	{
+		engineEvent(event);
+		return;
+	}
 	switch (event->type)
 	{
 		case SDL_QUIT:
 			quit = true;
 			break;
+		case SDL_WINDOWEVENT:
+			if (event->window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+			{
+				int width, height;
+
+				// Lay out in pixels, which outnumber the window points of
+				// the event on HiDPI displays
+				if (SDL_GetRendererOutputSize(window_renderer, &width,
+							&height) == 0)
+				{
+					board->resize(width, height);
+					board->render();
+				}
+			}
+			break;
+		case SDL_KEYDOWN:
+			// 'a' starts or stops analysing the position on the board
+			if (event->key.keysym.sym == SDLK_a)
+			{
+				analysing = !analysing;
+				if (analysing)
+					postAnalysis();
+				else if (engine_request == 0)
+					worker->cancel();
+			}
+			// 'f' prints the FEN of the position on the board
+			if (event->key.keysym.sym == SDLK_f)
+			{
+				char fen[MAX_FEN_LENGTH];
+
+				board->getFen(fen);
+				printf("%s\n", fen);
+			}
+			// The arrow keys step through a game loaded from PGN
+			if (replay && engine_request == 0 &&
+					(event->key.keysym.sym == SDLK_LEFT ||
+					 event->key.keysym.sym == SDLK_RIGHT))
+			{
+				stepReplay(event->key.keysym.sym == SDLK_LEFT ?
+						replay_ply - 1 : replay_ply + 1);
+				board->render();
+			}
+			// 'h' shows or hides the metrics HUD
+			if (event->key.keysym.sym == SDLK_h)
+			{
+				board->toggleHud();
+				board->render();
+			}
+			break;
 		case SDL_MOUSEBUTTONDOWN:
-			int x = event->button.x;
-			int y = event->button.y;
+			int x = event->button.x * pixelScale();
+			int y = event->button.y * pixelScale();
 			int pad = board->getBoardPad();
+			int end = pad + board->getGridSize() * 8;
 			Piece* clicked_piece;
 
-			if ((x > pad) && (x <= (BOARD_SIZE - pad)) &&
-					(y > pad) && (y <= (BOARD_SIZE - pad)))
+			// The board is frozen while the engine thinks about its move,
+			// and for good once the game is drawn
+			if (engine_request == 0 && board->drawState() == NO_DRAW &&
+					(x > pad) && (x < end) && (y > pad) && (y < end))
 			{
 				int grid_x_pos = (int) floor((x - pad) / board->getGridSize());
 				int grid_y_pos = (int) floor((y - pad) / board->getGridSize());
@@ -86,19 +235,14 @@ void eventHandler(SDL_Event* event)
 				{
 					if (active_piece != nullptr && board->isPieceTurn(active_piece))
 					{
-						if ((!board->underCheck(active_piece) &&
-								active_piece->canMove(grid_x_pos, grid_y_pos)
-								&& !board->isPiecePinned(active_piece)) ||
-								board->isIntercept(active_piece, grid_x_pos, grid_y_pos))
+						if (board->isLegalMove(active_piece, grid_x_pos, grid_y_pos))
 						{
-							board->setLastMove(active_piece->getX(), grid_x_pos,
-									active_piece->getY(), grid_y_pos,
-									active_piece->getPieceType());
 							board->movePiece(active_piece, grid_x_pos, grid_y_pos);
+							board->animateLastMove();
 							active_piece = nullptr;
 							board->flipTurn();
 							board->check(nullptr);
-							board->updatePieceIntercept();
+							afterMove();
 						}
 					}
 				} else
@@ -109,19 +253,7 @@ void eventHandler(SDL_Event* event)
 						{
 							active_piece = clicked_piece;
 							board->highlight(grid_x_pos, grid_y_pos, PIECE);
-							if (!board->underCheck(active_piece))
-							{
-								if (!board->isPiecePinned(active_piece))
-									board->highlightRoute(active_piece);
-								else
-									board->highlightRoute(active_piece, true);
-							} else
-							{
-								if (active_piece->getPieceType() == KING)
-									board->highlightKingEvade();
-								else
-									board->highlightInterceptRoute(active_piece);
-							}
+							board->highlightRoute(active_piece);
 						}
 					} else
 					{
@@ -131,23 +263,21 @@ void eventHandler(SDL_Event* event)
 							board->drawBoard();
 						} else
 						{
-							if ((!board->underCheck(active_piece) &&
-									active_piece->canMove(grid_x_pos, grid_y_pos)
-									&& !board->isPiecePinned(active_piece)) ||
-									board->isIntercept(active_piece, grid_x_pos, grid_y_pos))
+							if (board->isLegalMove(active_piece, grid_x_pos,
+										grid_y_pos))
 							{
-								board->setLastMove(active_piece->getX(), grid_x_pos,
-										active_piece->getY(), grid_y_pos,
-										active_piece->getPieceType());
 								board->movePiece(active_piece, grid_x_pos, grid_y_pos);
+								board->animateLastMove();
 								active_piece = nullptr;
 								board->flipTurn();
 								board->check(nullptr);
-								board->updatePieceIntercept();
+								afterMove();
 							}
 						}
 					}
 				}
+				// Shows the highlights and moves of this click in one frame
+				board->render();
 			} else
 			{
 				// Handles clicks outside the boundaries of the board
@@ -155,3 +285,204 @@ void eventHandler(SDL_Event* event)
 			}
 	}
 }
+
+/**
+ * loadGame - Reads a game of a PGN file to step through with the arrow keys,
+ * streaming past the games before it
+ *
+ * @path: PGN file
+ * @number: Number of the game in the file, counted from 1
+ *
+ * Return: true if the game was loaded, false otherwise
+ */
+bool loadGame(const char* path, int number)
+{
+	PgnReader* reader;
+	FILE* file;
+	bool found;
+
+	file = fopen(path, "r");
+	if (file == nullptr)
+	{
+		printf("Unable to open %s\n", path);
+		return (false);
+	}
+	reader = new PgnReader(file);
+	replay = new PgnGame;
+	found = false;
+	while (!found && reader->next(*replay))
+		found = reader->games() == (uint64_t) number;
+	delete reader;
+	fclose(file);
+	if (!found)
+	{
+		printf("No game %d in %s\n", number, path);
+		delete replay;
+		replay = nullptr;
+		return (false);
+	}
+
+	printf("%s - %s %s, %d plies%s\n", replay->white, replay->black,
+			replay->result, replay->move_count,
+			replay->error ? ", stopped at an unreadable move" : "");
+	if (replay->fen[0] && !board->setFen(replay->fen))
+	{
+		delete replay;
+		replay = nullptr;
+		return (false);
+	}
+	replay_ply = 0;
+	replay_key = board->getKey();
+	return (true);
+}
+
+/**
+ * stepReplay - Shows the position after a number of plies of the loaded
+ * game. The next ply is played and animated, any other one is set up again
+ * from the start of the game, as is the board after a move by hand
+ *
+ * @ply: Number of plies to show, out of range ones are ignored
+ *
+ * Return: Nothing
+ */
+void stepReplay(int ply)
+{
+	char name[6];
+
+	if (ply < 0 || ply > replay->move_count)
+		return;
+	active_piece = nullptr;
+	board->clearHighlights();
+	if (ply == replay_ply + 1 && board->getKey() == replay_key)
+	{
+		board->playMove(replay->moves[replay_ply]);
+		board->animateLastMove();
+	} else
+	{
+		board->setFen(replay->fen[0] ? replay->fen : START_FEN);
+		for (int i = 0; i < ply; i++)
+			board->playMove(replay->moves[i]);
+	}
+	replay_ply = ply;
+	replay_key = board->getKey();
+	if (ply > 0)
+	{
+		moveName(replay->moves[ply - 1], name);
+		printf("%d%s %s\n", (ply + 1) / 2, ply % 2 ? "." : "...", name);
+	}
+	gameDrawn();
+	postAnalysis();
+}
+
+/**
+ * gameDrawn - Checks whether the last move drew the game, announcing the
+ * draw if it did
+ *
+ * Return: true if the game is drawn, false Otherwise
+ */
+bool gameDrawn(void)
+{
+	switch (board->drawState())
+	{
+		case REPETITION_DRAW:
+			printf("Draw by threefold repetition\n");
+			return (true);
+		case FIFTY_MOVE_DRAW:
+			printf("Draw by the fifty-move rule\n");
+			return (true);
+		default:
+			return (false);
+	}
+}
+
+/**
+ * afterMove - Hands the new position to the engine, to play black's reply
+ * when it plays black or to analyse when analysis is on. Nothing is posted
+ * once the game is drawn
+ *
+ * Return: Nothing
+ */
+void afterMove(void)
+{
+	SearchLimits limits;
+
+	if (gameDrawn())
+		return;
+	if (engine_movetime > 0 && board->blackTurn())
+	{
+		limits.depth = 0;
+		limits.nodes = 0;
+		limits.movetime = engine_movetime;
+		engine_request = worker->post(board->getPosition(), limits);
+	} else
+		postAnalysis();
+}
+
+/**
+ * postAnalysis - Starts an analysis of the board without limits, replacing
+ * the previous one, if analysis is on
+ *
+ * Return: Nothing
+ */
+void postAnalysis(void)
+{
+	SearchLimits limits;
+
+	if (!analysing || engine_request != 0)
+		return;
+	limits.depth = 0;
+	limits.nodes = 0;
+	limits.movetime = 0;
+	worker->post(board->getPosition(), limits);
+}
+
+/**
+ * engineEvent - Handles a result sent by the worker, printing progress and
+ * playing the engine's move once its search is over
+ *
+ * @event: Worker event, user.data1 holding the SearchResult to free
+ *
+ * Return: Nothing
+ */
+void engineEvent(SDL_Event* event)
+{
+	SearchResult* result;
+	char name[6];
+
+	result = (SearchResult *) event->user.data1;
+	if (worker->isCurrent(event->user.code))
+	{
+		moveName(result->best_move, name);
+		printf("%s: %s score %d depth %d nodes %llu nps %llu\n",
+				event->type == worker->progressEvent() ? "info" : "best",
+				result->best_move.isNull() ? "none" : name, result->score,
+				result->depth, (unsigned long long) result->nodes,
+				(unsigned long long) result->nps);
+		if (event->type == worker->bestMoveEvent() &&
+				event->user.code == engine_request)
+		{
+			engine_request = 0;
+			playEngineMove(result);
+			board->render();
+			if (!gameDrawn())
+				postAnalysis();
+		}
+	}
+	delete result;
+}
+
+/**
+ * playEngineMove - Plays the best move of a finished engine search
+ *
+ * @result: Result of the search
+ *
+ * Return: Nothing
+ */
+void playEngineMove(const SearchResult* result)
+{
+	if (result->best_move.isNull())
+		return;
+
+	board->playMove(result->best_move);
+	board->animateLastMove();
+}
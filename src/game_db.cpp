@@ -0,0 +1,330 @@
+#include "../headers/game_db.h"
+#include <algorithm>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+GameDbWriter::GameDbWriter(void)
+{
+	// Offset 0 of the pool is the empty string
+	m_strings.push_back('\0');
+}
+
+/**
+ * addString - Adds a tag to the string pool, the empty string being shared
+ *
+ * @s: Tag to add
+ *
+ * Return: Offset of the tag in the pool
+ */
+uint32_t GameDbWriter::addString(const char *s)
+{
+	uint32_t offset;
+
+	if (s[0] == '\0')
+		return (0);
+	offset = (uint32_t) m_strings.size();
+	m_strings.insert(m_strings.end(), s, s + strlen(s) + 1);
+	return (offset);
+}
+
+/**
+ * add - Adds a game read from PGN, indexing every position it goes through.
+ * A game stopped by an unreadable move keeps the moves before it
+ *
+ * @game: Game to add
+ *
+ * Return: true on success, false if its start FEN is invalid
+ */
+bool GameDbWriter::add(const PgnGame &game)
+{
+	GameDbRecord record;
+	GameDbEntry entry;
+
+	if (!m_board.setFen(game.fen[0] ? game.fen : START_FEN))
+		return (false);
+	record.first_move = m_moves.size();
+	record.move_count = (uint32_t) game.move_count;
+	record.event = addString(game.event);
+	record.date = addString(game.date);
+	record.white = addString(game.white);
+	record.black = addString(game.black);
+	record.result = addString(game.result);
+	record.fen = addString(game.fen);
+
+	entry.game = (uint32_t) m_games.size();
+	for (int ply = 0; ply <= game.move_count; ply++)
+	{
+		entry.key = m_board.key();
+		entry.ply = (uint32_t) ply;
+		m_index.push_back(entry);
+		if (ply == game.move_count)
+			break;
+		m_board.makeMove(game.moves[ply]);
+		m_moves.push_back(game.moves[ply].raw());
+	}
+	m_games.push_back(record);
+	return (true);
+}
+
+/**
+ * entryBefore - Orders index entries by key, then by game and ply
+ *
+ * @a: First entry
+ * @b: Second entry
+ *
+ * Return: true if a goes before b, false Otherwise
+ */
+static bool entryBefore(const GameDbEntry &a, const GameDbEntry &b)
+{
+	if (a.key != b.key)
+		return (a.key < b.key);
+	if (a.game != b.game)
+		return (a.game < b.game);
+	return (a.ply < b.ply);
+}
+
+/**
+ * writeSection - Writes a section of the file, padded to 8 bytes
+ *
+ * @file: File to write to
+ * @data: Section to write
+ * @size: Size of the section in bytes
+ *
+ * Return: true on success, false otherwise
+ */
+static bool writeSection(FILE *file, const void *data, uint64_t size)
+{
+	static const char padding[8] = { 0 };
+	uint64_t pad;
+
+	pad = (8 - size % 8) % 8;
+	if (size && fwrite(data, 1, size, file) != size)
+		return (false);
+	return (fwrite(padding, 1, pad, file) == pad);
+}
+
+/**
+ * alignedSize - Size of a section once padded to 8 bytes
+ *
+ * @size: Size of the section in bytes
+ *
+ * Return: The padded size
+ */
+static uint64_t alignedSize(uint64_t size)
+{
+	return ((size + 7) & ~(uint64_t) 7);
+}
+
+/**
+ * write - Sorts the position index and writes the database out
+ *
+ * @path: File to write, replaced if it exists
+ *
+ * Return: true on success, false otherwise
+ */
+bool GameDbWriter::write(const char *path)
+{
+	GameDbHeader header;
+	FILE *file;
+	bool ok;
+
+	std::sort(m_index.begin(), m_index.end(), entryBefore);
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, GAME_DB_MAGIC, sizeof(header.magic));
+	header.game_count = m_games.size();
+	header.move_count = m_moves.size();
+	header.index_count = m_index.size();
+	header.string_size = m_strings.size();
+	header.games_offset = alignedSize(sizeof(header));
+	header.moves_offset = header.games_offset +
+		alignedSize(m_games.size() * sizeof(GameDbRecord));
+	header.strings_offset = header.moves_offset +
+		alignedSize(m_moves.size() * sizeof(uint16_t));
+	header.index_offset = header.strings_offset +
+		alignedSize(m_strings.size());
+
+	file = fopen(path, "wb");
+	if (file == nullptr)
+		return (false);
+	ok = writeSection(file, &header, sizeof(header)) &&
+		writeSection(file, m_games.data(),
+				m_games.size() * sizeof(GameDbRecord)) &&
+		writeSection(file, m_moves.data(),
+				m_moves.size() * sizeof(uint16_t)) &&
+		writeSection(file, m_strings.data(), m_strings.size()) &&
+		writeSection(file, m_index.data(),
+				m_index.size() * sizeof(GameDbEntry));
+	if (fclose(file) != 0)
+		ok = false;
+	return (ok);
+}
+
+GameDb::GameDb(void)
+{
+	m_map = nullptr;
+	m_size = 0;
+	m_header = nullptr;
+	m_games = nullptr;
+	m_moves = nullptr;
+	m_strings = nullptr;
+	m_index = nullptr;
+}
+
+GameDb::~GameDb(void)
+{
+	close();
+}
+
+/**
+ * sectionFits - Checks that a section lies within the mapped file
+ *
+ * @offset: Offset of the section
+ * @count: Number of elements in it
+ * @size: Size of an element
+ * @file_size: Size of the file
+ *
+ * Return: true if the section fits, false otherwise
+ */
+static bool sectionFits(uint64_t offset, uint64_t count, uint64_t size,
+		uint64_t file_size)
+{
+	return (offset % 8 == 0 && offset <= file_size &&
+			count <= (file_size - offset) / size);
+}
+
+/**
+ * open - Maps a database file, replacing the one open. Only the header is
+ * checked, nothing else is read
+ *
+ * @path: File to map
+ *
+ * Return: true on success, false if the file cannot be mapped or is not a
+ * game database
+ */
+bool GameDb::open(const char *path)
+{
+	const GameDbHeader *header;
+	struct stat st;
+	void *map;
+	int fd;
+
+	close();
+	fd = ::open(path, O_RDONLY);
+	if (fd < 0)
+		return (false);
+	if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(GameDbHeader))
+	{
+		::close(fd);
+		return (false);
+	}
+	map = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (map == MAP_FAILED)
+		return (false);
+	m_map = (const char *) map;
+	m_size = st.st_size;
+
+	header = (const GameDbHeader *) m_map;
+	if (memcmp(header->magic, GAME_DB_MAGIC, sizeof(header->magic)) != 0 ||
+			!sectionFits(header->games_offset, header->game_count,
+				sizeof(GameDbRecord), m_size) ||
+			!sectionFits(header->moves_offset, header->move_count,
+				sizeof(uint16_t), m_size) ||
+			!sectionFits(header->strings_offset, header->string_size, 1,
+				m_size) ||
+			!sectionFits(header->index_offset, header->index_count,
+				sizeof(GameDbEntry), m_size) ||
+			header->string_size == 0 ||
+			m_map[header->strings_offset + header->string_size - 1] != '\0')
+	{
+		close();
+		return (false);
+	}
+	m_header = header;
+	m_games = (const GameDbRecord *) (m_map + header->games_offset);
+	m_moves = (const uint16_t *) (m_map + header->moves_offset);
+	m_strings = m_map + header->strings_offset;
+	m_index = (const GameDbEntry *) (m_map + header->index_offset);
+
+	// Lookups land anywhere in the index, reading ahead would only waste
+	// I/O
+	madvise(map, m_size, MADV_RANDOM);
+	return (true);
+}
+
+/**
+ * close - Unmaps the database, if one is open
+ *
+ * Return: Nothing
+ */
+void GameDb::close(void)
+{
+	if (m_map)
+		munmap((void *) m_map, m_size);
+	m_map = nullptr;
+	m_size = 0;
+	m_header = nullptr;
+	m_games = nullptr;
+	m_moves = nullptr;
+	m_strings = nullptr;
+	m_index = nullptr;
+}
+
+/**
+ * lowerBound - Finds the first entry of the index whose key is not below a
+ * key, with a binary search touching about log2(entries) of them
+ *
+ * @index: Sorted index
+ * @count: Number of entries in index
+ * @key: Key to look for
+ * @above: Whether to find the first key above key instead
+ *
+ * Return: Position of the entry, count if there is none
+ */
+static uint64_t lowerBound(const GameDbEntry *index, uint64_t count,
+		uint64_t key, bool above)
+{
+	uint64_t low, high;
+
+	low = 0;
+	high = count;
+	while (low < high)
+	{
+		uint64_t mid;
+
+		mid = low + (high - low) / 2;
+		if (index[mid].key < key || (above && index[mid].key == key))
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	return (low);
+}
+
+/**
+ * find - Looks a position up in the index. Two binary searches bound the
+ * entries of the position, however many games reach it
+ *
+ * @key: Zobrist key of the position
+ * @count: Set to the number of entries for the position
+ *
+ * Return: First entry for the position, by game and ply, nullptr if no game
+ * reaches it
+ */
+const GameDbEntry *GameDb::find(uint64_t key, uint64_t *count) const
+{
+	uint64_t first, last;
+
+	*count = 0;
+	if (m_header == nullptr)
+		return (nullptr);
+	first = lowerBound(m_index, m_header->index_count, key, false);
+	last = lowerBound(m_index + first, m_header->index_count - first, key,
+			true) + first;
+	*count = last - first;
+	return (*count ? m_index + first : nullptr);
+}
@@ -0,0 +1,138 @@
+#include "../headers/game.h"
+#include <SDL2/SDL_image.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * nextFen - Reads the next FEN of a file, skipping blank lines and lines
+ * starting with '#'
+ *
+ * @file: File to read from
+ * @line: Buffer the FEN is written to, without its newline
+ * @size: Size of line
+ *
+ * Return: true if a FEN was read, false at the end of the file
+ */
+static bool nextFen(FILE* file, char* line, int size)
+{
+	while (fgets(line, size, file))
+	{
+		line[strcspn(line, "\r\n")] = '\0';
+		if (line[0] != '\0' && line[0] != '#')
+			return (true);
+	}
+	return (false);
+}
+
+/**
+ * headless - Renders positions through the software renderer into an
+ * offscreen surface, so no window or display is needed, optionally saves
+ * each one as a PNG snapshot and prints how long rendering took
+ *
+ * @fen_path: File with one FEN per line, nullptr for the start position
+ * @out_dir: Directory the snapshots are written to, nullptr for none
+ * @repeat: Number of times each position is rendered from scratch
+ *
+ * Return: Nothing
+ */
+void headless(const char* fen_path, const char* out_dir, int repeat)
+{
+	SDL_Surface* surface;
+	SDL_Renderer* renderer;
+	ChessBoard* offscreen;
+	Position pos;
+	FILE* file;
+	char line[256], path[512];
+	Uint64 begin, ticks, render_ticks, min_ticks, max_ticks, png_ticks;
+	double freq;
+	int positions, frames, failed;
+
+	if (!initHeadless())
+	{
+		wrapUp();
+		return;
+	}
+	renderer = createOffscreenRenderer(&surface, SCREEN_WIDTH, SCREEN_HEIGHT);
+	if (renderer == nullptr)
+	{
+		wrapUp();
+		return;
+	}
+	file = nullptr;
+	if (fen_path && (file = fopen(fen_path, "r")) == nullptr)
+	{
+		fprintf(stderr, "Unable to open %s\n", fen_path);
+		SDL_DestroyRenderer(renderer);
+		SDL_FreeSurface(surface);
+		wrapUp();
+		return;
+	}
+
+	offscreen = new ChessBoard(renderer);
+	freq = (double) SDL_GetPerformanceFrequency();
+	render_ticks = 0;
+	min_ticks = 0;
+	max_ticks = 0;
+	png_ticks = 0;
+	positions = 0;
+	frames = 0;
+	failed = 0;
+	if (file == nullptr)
+		strcpy(line, START_FEN);
+	while (file ? nextFen(file, line, sizeof(line)) : positions == 0)
+	{
+		if (!pos.setFen(line))
+		{
+			fprintf(stderr, "Invalid FEN: %s\n", line);
+			failed++;
+			if (file == nullptr)
+				break;
+			continue;
+		}
+
+		// Every repeat redraws all layers, like the first frame of a board
+		for (int i = 0; i < repeat; i++)
+		{
+			offscreen->invalidate();
+			begin = SDL_GetPerformanceCounter();
+			offscreen->renderPosition(pos);
+			ticks = SDL_GetPerformanceCounter() - begin;
+			render_ticks += ticks;
+			if (frames == 0 || ticks < min_ticks)
+				min_ticks = ticks;
+			if (ticks > max_ticks)
+				max_ticks = ticks;
+			frames++;
+		}
+
+		if (out_dir)
+		{
+			snprintf(path, sizeof(path), "%s/%05d.png", out_dir, positions);
+			begin = SDL_GetPerformanceCounter();
+			if (IMG_SavePNG(surface, path) != 0)
+			{
+				fprintf(stderr, "Unable to save %s: %s\n", path,
+						IMG_GetError());
+				failed++;
+			}
+			png_ticks += SDL_GetPerformanceCounter() - begin;
+		}
+		positions++;
+	}
+
+	printf("positions %d frames %d failed %d\n", positions, frames, failed);
+	if (frames > 0)
+		printf("render ms: mean %.3f min %.3f max %.3f (%.1f frames/s)\n",
+				render_ticks * 1000.0 / freq / frames,
+				min_ticks * 1000.0 / freq, max_ticks * 1000.0 / freq,
+				frames * freq / (render_ticks ? render_ticks : 1));
+	if (out_dir && positions > 0)
+		printf("png ms: mean %.3f\n", png_ticks * 1000.0 / freq / positions);
+
+	if (file)
+		fclose(file);
+	delete offscreen;
+	SDL_DestroyRenderer(renderer);
+	SDL_FreeSurface(surface);
+	wrapUp();
+}
@@ -1,9 +1,11 @@
 #include "../headers/game.h"
 #include "../headers/pieces.h"
 #include "../headers/moves.h"
+#include "../headers/metrics.h"
 
 /**
- * highlight - Handles the highlighting of squares based on the highlight type
+ * highlight - Records the highlight of a grid based on the highlight type,
+ * drawn on the highlight layer by the next render call
  *
  * @x: x position of piece to highlight
  * @y: y position of piece to highlight
@@ -13,85 +15,53 @@
  */
 void ChessBoard::highlight(int x, int y, HighlightType type)
 {
-	SDL_Texture* h_texture;
-	SDL_Rect h_square;
-	float xpos, ypos;
-	int p_offset;
-
-	p_offset = 5;
-	xpos = x * m_grid_size + m_board_pad + p_offset;
-	ypos = y * m_grid_size + m_board_pad + p_offset;
-
+	int sprite;
 
+	if (x < 0 || x > 7 || y < 0 || y > 7)
+		return;
 	if (type == PIECE)
 		if ((x + y) % 2 == 0)
-			h_texture = loadImage("assets/active_black_piece.png", m_renderer);
+			sprite = ACTIVE_BLACK_SPRITE;
 		else
-			h_texture = loadImage("assets/active_white_piece.png", m_renderer);
+			sprite = ACTIVE_WHITE_SPRITE;
 	else if (type == MOVE)
-		h_texture = loadImage("assets/possible_squares.png", m_renderer);
+		sprite = MOVE_SPRITE;
 	else if (type == CAPTURE)
-		h_texture = loadImage("assets/possible_capture.png", m_renderer);
-	else if (type == CASTLING)
-		h_texture = loadImage("assets/castling_square.png", m_renderer);
-
-	// Throw exception if asset could not be loaded
-	if (h_texture == nullptr)
-	{
-		SDL_Log("Failed to load active_piece image!!!");
-		// Throw Exception
-		return;
-	}
-
-	h_square = { (int) xpos, (int) ypos, (m_grid_size - p_offset),
-		(m_grid_size - p_offset)};
-	SDL_SetRenderTarget(m_renderer, m_chess_board);
-	SDL_RenderCopy(m_renderer, h_texture, nullptr, &h_square);
-	SDL_RenderPresent(m_renderer);
-	SDL_SetRenderTarget(m_renderer, nullptr);
+		sprite = CAPTURE_SPRITE;
+	else
+		sprite = CASTLING_SPRITE;
+	m_overlays[x][y] = sprite;
 }
 
 /**
- * highlightRoute - Highlights the route of different grid(s) a piece can move
- * to on the board
+ * highlightRoute - Highlights the grid(s) a piece can legally move to on the
+ * board, read from the legal move cache
  *
  * @p: Pointer to the piece whoose route should be highlighted
- * @pinned: Boolean parameter indicating whether or not the piece to highlight
- * is pinned
  *
  * Return: Nothing
  */
-void ChessBoard::highlightRoute(Piece* p, bool pinned)
+void ChessBoard::highlightRoute(Piece* p)
 {
-	int x, y;
+	LatencyTimer timer(HIGHLIGHT_METRIC);
+	Bitboard targets;
+	int from;
 
 	if (!p)
 		return;
-	x = p->getX();
-	y = p->getY();
-	switch(p->getPieceType())
+	targets = legalTargets(p);
+	from = square(p->getX(), p->getY());
+	while (targets)
 	{
-		case PAWN:
-			highlightPawnRoutes(p);
-			break;
-		case KNIGHT:
-			highlightKnightRoutes(p, pinned);
-			break;
-		case BISHOP:
-			highlightDiagonal(p, pinned);
-			break;
-		case ROOK:
-			highlightStraight(p, pinned);
-			break;
-		case QUEEN:
-			highlightDiagonal(p, pinned);
-			highlightStraight(p, pinned);
-			break;
-		case KING:
-			highlightKingRoutes(p);
-			break;
-		default:
-			break;
+		int to;
+
+		to = popLsb(targets);
+		if (p->getPieceType() == KING && (m_legal_castles & squareBit(to)))
+			highlight(squareX(to), squareY(to), CASTLING);
+		else if (m_legal_captures[from] & squareBit(to))
+			highlight(squareX(to), squareY(to), CAPTURE);
+		else
+			highlight(squareX(to), squareY(to), MOVE);
 	}
 }
 
@@ -150,87 +150,6 @@ void ChessBoard::highlightKingRoutes(Piece* p)
 	}
 }
 
-/**
- * highlightPawnRoutes - Renders the appropriate highlight for the selected
- * pawn piece
- *
- * @p: Pointer to the selected pawn piece
- *
- * Return: Nothing
- */
-void ChessBoard::highlightPawnRoutes(Piece* p)
-{
-	Pawn* piece;
-	Piece* tmp_piece1, *tmp_piece2;
-	int x, y;
-
-	if (!p)
-		return;
-	x = p->getX();
-	y = p->getY();
-	// Using dynamic_cast to perform polymorphic cast
-	piece = dynamic_cast<Pawn*>(p);
-
-	// Handles two-square advances
-	if (!piece->hasMoved())
-		tmp_piece1 = piece->isBlack() ? m_board[x][y - 2]
-			: m_board[x][y + 2];
-	else
-		tmp_piece1 = nullptr;
-	// Using +1 and -1 cause depending on the side it moves
-	// forward or backward and we want the prior piece
-	tmp_piece2 = piece->isBlack() ? m_board[x][y - 1]
-		: m_board[x][y + 1];
-
-	if (!tmp_piece2)
-	{
-		if (piece->isBlack())
-			highlight(x, y - 1, MOVE);
-		else
-			highlight(x, y + 1, MOVE);
-		if (!piece->hasMoved() && !tmp_piece1)
-			if (piece->isBlack())
-				highlight(x, y - 2, MOVE);
-			else
-				highlight(x, y + 2, MOVE);
-	}
-
-	if (piece->isBlack())
-	{
-		// Prevents trying to access values outside the 8x8 array
-		tmp_piece1 = x > 0 && y > 0 ? m_board[x - 1][y - 1] : nullptr;
-		tmp_piece2 = x < 7 && y > 0 ? m_board[x + 1][y - 1] : nullptr;
-	} else
-	{
-		// Prevents trying to access values outside the 8x8 array
-		tmp_piece1 = x > 0 && y < 7 ? m_board[x - 1][y + 1] : nullptr;
-		tmp_piece2 = x < 7 && y < 7 ? m_board[x + 1][y + 1] : nullptr;
-	}
-
-	if (tmp_piece1 && piece->isOpponent(tmp_piece1))
-		highlight(tmp_piece1->getX(), tmp_piece1->getY(), CAPTURE);
-	if (tmp_piece2 && piece->isOpponent(tmp_piece2))
-		highlight(tmp_piece2->getX(), tmp_piece2->getY(), CAPTURE);
-
-	// En passant
-	if (y == 4 && piece->isWhite() || y == 3 && piece->isBlack())
-	{
-		if (m_last_move->getPieceType() == PAWN)
-		{
-			if (abs(m_last_move->fromY() - m_last_move->toY()) == 2
-					&& abs(x - m_last_move->fromX()) == 1)
-			{
-				int x_capt, y_capt;
-
-				x_capt = m_last_move->fromX();
-				y_capt = piece->isBlack() ? m_last_move->toY() - 1
-					: m_last_move->toY() + 1;
-				highlight(x_capt, y_capt, CAPTURE);
-			}
-		}
-	}
-}
-
 /**
  * highlightKnightRoutes - Renders the appropriate highlight for the selected
  * knight piece
@@ -0,0 +1,182 @@
+#include "../headers/hud.h"
+#include "../headers/metrics.h"
+#include <stdio.h>
+
+// Every font pixel is drawn as a HUD_SCALE by HUD_SCALE square
+const int HUD_SCALE = 2;
+const int HUD_MARGIN = 8;
+const int GLYPH_WIDTH = 5;
+const int GLYPH_HEIGHT = 7;
+
+// Rows of each glyph from ' ' to 'Z', most significant bit leftmost
+static const unsigned char glyphs[][GLYPH_HEIGHT] = {
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ' '
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '!'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '"'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '#'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '$'
+	{ 0x19, 0x1a, 0x02, 0x04, 0x08, 0x0b, 0x13 }, // '%'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '&'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '''
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '('
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ')'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '*'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '+'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ','
+	{ 0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00 }, // '-'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x06 }, // '.'
+	{ 0x01, 0x02, 0x02, 0x04, 0x08, 0x08, 0x10 }, // '/'
+	{ 0x0e, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0e }, // '0'
+	{ 0x04, 0x0c, 0x04, 0x04, 0x04, 0x04, 0x0e }, // '1'
+	{ 0x0e, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1f }, // '2'
+	{ 0x1f, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0e }, // '3'
+	{ 0x02, 0x06, 0x0a, 0x12, 0x1f, 0x02, 0x02 }, // '4'
+	{ 0x1f, 0x10, 0x1e, 0x01, 0x01, 0x11, 0x0e }, // '5'
+	{ 0x06, 0x08, 0x10, 0x1e, 0x11, 0x11, 0x0e }, // '6'
+	{ 0x1f, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 }, // '7'
+	{ 0x0e, 0x11, 0x11, 0x0e, 0x11, 0x11, 0x0e }, // '8'
+	{ 0x0e, 0x11, 0x11, 0x0f, 0x01, 0x02, 0x0c }, // '9'
+	{ 0x00, 0x0c, 0x0c, 0x00, 0x0c, 0x0c, 0x00 }, // ':'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ';'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '<'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '='
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '>'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '?'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '@'
+	{ 0x0e, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11 }, // 'A'
+	{ 0x1e, 0x11, 0x11, 0x1e, 0x11, 0x11, 0x1e }, // 'B'
+	{ 0x0e, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0e }, // 'C'
+	{ 0x1c, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1c }, // 'D'
+	{ 0x1f, 0x10, 0x10, 0x1e, 0x10, 0x10, 0x1f }, // 'E'
+	{ 0x1f, 0x10, 0x10, 0x1e, 0x10, 0x10, 0x10 }, // 'F'
+	{ 0x0e, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0f }, // 'G'
+	{ 0x11, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11 }, // 'H'
+	{ 0x0e, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0e }, // 'I'
+	{ 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0c }, // 'J'
+	{ 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 }, // 'K'
+	{ 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1f }, // 'L'
+	{ 0x11, 0x1b, 0x15, 0x15, 0x11, 0x11, 0x11 }, // 'M'
+	{ 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 }, // 'N'
+	{ 0x0e, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e }, // 'O'
+	{ 0x1e, 0x11, 0x11, 0x1e, 0x10, 0x10, 0x10 }, // 'P'
+	{ 0x0e, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0d }, // 'Q'
+	{ 0x1e, 0x11, 0x11, 0x1e, 0x14, 0x12, 0x11 }, // 'R'
+	{ 0x0f, 0x10, 0x10, 0x0e, 0x01, 0x01, 0x1e }, // 'S'
+	{ 0x1f, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // 'T'
+	{ 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e }, // 'U'
+	{ 0x11, 0x11, 0x11, 0x11, 0x11, 0x0a, 0x04 }, // 'V'
+	{ 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0a }, // 'W'
+	{ 0x11, 0x11, 0x0a, 0x04, 0x0a, 0x11, 0x11 }, // 'X'
+	{ 0x11, 0x11, 0x0a, 0x04, 0x04, 0x04, 0x04 }, // 'Y'
+	{ 0x1f, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1f }, // 'Z'
+};
+
+/**
+ * Hud - Creates a hidden HUD
+ *
+ * @renderer: Renderer the HUD is drawn with
+ * @compositor: Compositor owning the HUD layer
+ *
+ * Return: Nothing
+ */
+Hud::Hud(SDL_Renderer* renderer, Compositor* compositor)
+{
+	m_renderer = renderer;
+	m_compositor = compositor;
+	m_visible = false;
+	m_drawn = false;
+}
+
+/**
+ * text - Queues the lit pixels of a line of text, lower case letters are
+ * shown in upper case and unknown characters as spaces
+ *
+ * @x: Left of the line
+ * @y: Top of the line
+ * @line: Text to show
+ *
+ * Return: Nothing
+ */
+void Hud::text(int x, int y, const char* line)
+{
+	for (int i = 0; line[i]; i++)
+	{
+		int c;
+
+		c = line[i] >= 'a' && line[i] <= 'z' ? line[i] - 'a' + 'A' : line[i];
+		if (c < ' ' || c > 'Z')
+			c = ' ';
+		for (int row = 0; row < GLYPH_HEIGHT; row++)
+		{
+			for (int col = 0; col < GLYPH_WIDTH; col++)
+			{
+				SDL_Rect pixel;
+
+				if (!(glyphs[c - ' '][row] & (1 << (GLYPH_WIDTH - 1 - col))))
+					continue;
+				pixel.x = x + (i * (GLYPH_WIDTH + 1) + col) * HUD_SCALE;
+				pixel.y = y + row * HUD_SCALE;
+				pixel.w = HUD_SCALE;
+				pixel.h = HUD_SCALE;
+				m_pixels.push_back(pixel);
+			}
+		}
+	}
+}
+
+/**
+ * draw - Re-renders the HUD onto its layer, or clears it once after it was
+ * hidden
+ *
+ * @area: Area of the window the HUD covers
+ *
+ * Return: Nothing
+ */
+void Hud::draw(const SDL_Rect* area)
+{
+	char line[32];
+	int x, y, line_height;
+
+	if (!m_visible && !m_drawn)
+		return;
+	m_compositor->begin(HUD_LAYER);
+	m_compositor->clearRect(area);
+	m_drawn = m_visible;
+	if (!m_visible)
+		return;
+
+	x = area->x + HUD_MARGIN;
+	y = area->y + HUD_MARGIN;
+	line_height = (GLYPH_HEIGHT + 2) * HUD_SCALE;
+	m_pixels.clear();
+	text(x, y, "LATENCY US");
+	y += line_height * 2;
+	for (int i = 0; i < METRIC_COUNT; i++)
+	{
+		const LatencyHistogram &h = metrics.histograms[i];
+
+		snprintf(line, sizeof(line), "%s %llu", metricName(i),
+				(unsigned long long) h.count());
+		text(x, y, line);
+		snprintf(line, sizeof(line), " P50 %llu",
+				(unsigned long long) h.percentile(50));
+		text(x, y + line_height, line);
+		snprintf(line, sizeof(line), " P95 %llu",
+				(unsigned long long) h.percentile(95));
+		text(x, y + line_height * 2, line);
+		snprintf(line, sizeof(line), " P99 %llu",
+				(unsigned long long) h.percentile(99));
+		text(x, y + line_height * 3, line);
+		y += line_height * 5;
+	}
+	snprintf(line, sizeof(line), "FRAMES %llu",
+			(unsigned long long) metrics.frames);
+	text(x, y, line);
+	snprintf(line, sizeof(line), "TEXTURES %llu",
+			(unsigned long long) metrics.textures);
+	text(x, y + line_height, line);
+
+	SDL_SetRenderDrawBlendMode(m_renderer, SDL_BLENDMODE_NONE);
+	SDL_SetRenderDrawColor(m_renderer, 255, 255, 255, 255);
+	SDL_RenderFillRects(m_renderer, m_pixels.data(), (int) m_pixels.size());
+}
@@ -1,18 +1,16 @@
 #include "../headers/pieces.h"
 #include "../headers/game.h"
 
-King::King(int x, int y, bool isBlack, SDL_Renderer* renderer, ChessBoard* board)
-	: Piece(x, y, isBlack, renderer, board)
+King::King(int x, int y, bool isBlack, ChessBoard* board)
+	: Piece(x, y, isBlack, board)
 {
 	piece_type = PieceType::KING;
 	if (isBlack)
 	{
-		piece_texture = loadImage("assets/black_king.png",
-				renderer);
+		sprite = BLACK_KING_SPRITE;
 	} else
 	{
-		piece_texture = loadImage("assets/white_king.png",
-				renderer);
+		sprite = WHITE_KING_SPRITE;
 	}
 	m_has_moved = false;
 	m_on_check = false;
@@ -41,7 +39,8 @@ bool King::canMove(int x_dest, int y_dest, Piece* prot)
 				return (true);
 		} else
 		{
-			if ((isOpponent(tmp) && !tmp->isCovered()) || tmp == prot)
+			if ((isOpponent(tmp) && !m_board->isExposed(this, x_dest, y_dest))
+					|| tmp == prot)
 				return (true);
 		}
 	}
@@ -64,11 +63,13 @@ bool King::canMove(int x_dest, int y_dest, Piece* prot)
 				return (false);
 		}
 		p = m_board->getPiece(right ? x_dest + 2 : x_dest - 1, y);
+		// Castling is not possible out of, through or into check
+		if (m_board->isAttacked(x, y, !is_black) ||
+				m_board->isAttacked(right ? x + 1 : x - 1, y, !is_black) ||
+				m_board->isAttacked(x_dest, y, !is_black))
+			return (false);
 		if (p && p->getPieceType() == ROOK)
 		{
-			// Add threats check.
-			// Castling should not be possible if the king passes
-			// through check or if castling will place him on check
 			Rook* r;
 
 			r = dynamic_cast<Rook*>(p);
@@ -1,21 +1,14 @@
 #include "../headers/pieces.h"
 #include "../headers/game.h"
 
-Knight::Knight(int x, int y, bool isBlack, SDL_Renderer* renderer, ChessBoard* board)
-	: Piece(x, y, isBlack, renderer, board)
+Knight::Knight(int x, int y, bool isBlack, ChessBoard* board)
+	: Piece(x, y, isBlack, board)
 {
 	piece_type = PieceType::KNIGHT;
 	if (isBlack)
-	{
-		piece_texture = (this->x == 1) ? loadImage(
-				"assets/black_knight.png", renderer) :
-			loadImage("assets/black_knight2.png", renderer);
-	} else
-	{
-		piece_texture = (this->x == 1) ? loadImage(
-				"assets/white_knight.png", renderer) :
-			loadImage("assets/white_knight2.png", renderer);
-	}
+		sprite = (this->x == 1) ? BLACK_KNIGHT_SPRITE : BLACK_KNIGHT2_SPRITE;
+	else
+		sprite = (this->x == 1) ? WHITE_KNIGHT_SPRITE : WHITE_KNIGHT2_SPRITE;
 }
 
 /**
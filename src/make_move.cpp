@@ -0,0 +1,173 @@
+#include "../headers/position.h"
+#include <stdlib.h>
+
+/**
+ * encodeMove - Builds the CompactMove of a piece going from one grid to
+ * another, deriving the flags from the current position
+ *
+ * @from: Origin grid of the moving piece
+ * @to: Destination grid
+ * @promotion: Piece a pawn reaching the last rank turns into
+ *
+ * Return: The encoded move, not checked for legality
+ */
+CompactMove Position::encodeMove(int from, int to, PieceType promotion) const
+{
+	static const int promotion_flags[6] = {
+		QUEEN_PROMOTION, QUEEN_PROMOTION, ROOK_PROMOTION, BISHOP_PROMOTION,
+		KNIGHT_PROMOTION, QUEEN_PROMOTION
+	};
+	PieceType type;
+	int flags;
+
+	type = pieceType(from);
+	flags = isEmpty(to) ? QUIET_MOVE : CAPTURE_MOVE;
+	if (type == PAWN)
+	{
+		if (abs(to - from) == 16)
+			flags = DOUBLE_PUSH;
+		else if (squareX(from) != squareX(to) && isEmpty(to))
+			flags = EN_PASSANT;
+		if (squareY(to) == 0 || squareY(to) == 7)
+			flags |= promotion_flags[promotion == NONE ? QUEEN : promotion];
+	} else if (type == KING && abs(to - from) == 2)
+		flags = to < from ? KING_SIDE_CASTLE : QUEEN_SIDE_CASTLE;
+	return (CompactMove(from, to, flags));
+}
+
+/**
+ * makeMove - Plays a move, pushing what it overwrites onto the undo stack.
+ * Nothing is freed or rendered, and nothing is allocated unless the game
+ * outgrows the stack. The Zobrist key is updated along the way by the
+ * piece, castling, en passant and turn setters
+ *
+ * @move: Legal move of the side to move
+ *
+ * Return: Nothing
+ */
+void Position::makeMove(CompactMove move)
+{
+	UndoRecord *undo;
+	int from, to, flags;
+	bool us;
+
+	from = move.from();
+	to = move.to();
+	flags = move.flags();
+	us = m_black_turn;
+
+	if (m_undo_size == (int) m_undo.size())
+		m_undo.resize(m_undo.size() * 2);
+	undo = &m_undo[m_undo_size++];
+	undo->move = move;
+	undo->captured = NONE;
+	undo->castling = m_castling;
+	undo->ep_square = (int8_t) m_ep_square;
+	undo->halfmove_clock = (uint16_t) m_halfmove_clock;
+	undo->key = m_key;
+
+	m_halfmove_clock++;
+	if (us)
+		m_fullmove++;
+	if (flags == EN_PASSANT)
+	{
+		int captured;
+
+		captured = to + (us ? 8 : -8);
+		undo->captured = m_mailbox[captured];
+		removePiece(captured);
+	} else if (move.isCapture())
+	{
+		undo->captured = m_mailbox[to];
+		removePiece(to);
+	}
+	if (move.isCapture() || pieceType(from) == PAWN)
+		m_halfmove_clock = 0;
+
+	movePiece(from, to);
+	if (flags == KING_SIDE_CASTLE)
+		movePiece(from - 3, from - 1);
+	else if (flags == QUEEN_SIDE_CASTLE)
+		movePiece(from + 4, from + 1);
+	else if (move.isPromotion())
+	{
+		removePiece(to);
+		putPiece(to, move.promotion(), us);
+	}
+
+	// The en passant grid is only kept, and hashed, when an enemy pawn could
+	// actually capture on it, so transpositions get the same key
+	if (flags == DOUBLE_PUSH &&
+			(pawnAttacks((from + to) / 2, us) & m_pieces[!us][PAWN]))
+		setEnPassantSquare((from + to) / 2);
+	else
+		setEnPassantSquare(NO_SQUARE);
+	updateCastlingRights(from, to);
+	flipTurn();
+}
+
+/**
+ * unmakeMove - Takes back the last move made with makeMove
+ *
+ * Return: Nothing
+ */
+void Position::unmakeMove(void)
+{
+	const UndoRecord *undo;
+	int from, to, flags;
+	bool us;
+
+	undo = &m_undo[--m_undo_size];
+	from = undo->move.from();
+	to = undo->move.to();
+	flags = undo->move.flags();
+	m_black_turn = !m_black_turn;
+	us = m_black_turn;
+
+	if (undo->move.isPromotion())
+	{
+		removePiece(to);
+		putPiece(to, PAWN, us);
+	}
+	movePiece(to, from);
+	if (flags == KING_SIDE_CASTLE)
+		movePiece(from - 1, from - 3);
+	else if (flags == QUEEN_SIDE_CASTLE)
+		movePiece(from + 1, from + 4);
+
+	if (undo->captured != NONE)
+	{
+		int captured;
+
+		captured = flags == EN_PASSANT ? to + (us ? 8 : -8) : to;
+		putPiece(captured, (PieceType) (undo->captured & 7),
+				(undo->captured >> 3) != 0);
+	}
+
+	m_castling = undo->castling;
+	m_ep_square = undo->ep_square;
+	m_halfmove_clock = undo->halfmove_clock;
+	if (us)
+		m_fullmove--;
+	m_key = undo->key;
+}
+
+/**
+ * leavesKingInCheck - Checks whether a move would leave the mover's own king
+ * attacked, by playing it and taking it back
+ *
+ * @move: Move of the side to move
+ *
+ * Return: true if the king would be left in check, false otherwise
+ */
+bool Position::leavesKingInCheck(CompactMove move)
+{
+	bool in_check;
+	int ksq;
+
+	makeMove(move);
+	ksq = kingSquare(!m_black_turn);
+	in_check = ksq != NO_SQUARE && isAttacked(ksq, m_black_turn);
+	unmakeMove();
+	return (in_check);
+}
@@ -0,0 +1,147 @@
+#include "../headers/metrics.h"
+#include <stdio.h>
+#include <string.h>
+
+Metrics metrics;
+
+LatencyHistogram::LatencyHistogram(void)
+{
+	memset(m_buckets, 0, sizeof(m_buckets));
+	m_count = 0;
+	m_total = 0;
+	m_max = 0;
+}
+
+/**
+ * bucketOf - Finds the bucket of a duration. Durations below
+ * HISTOGRAM_SUB_BUCKETS get a bucket each, larger ones share
+ * HISTOGRAM_SUB_BUCKETS buckets per power of two
+ *
+ * @us: Duration in microseconds
+ *
+ * Return: Index of the bucket
+ */
+int LatencyHistogram::bucketOf(uint64_t us)
+{
+	int shift, bucket;
+
+	if (us < (uint64_t) HISTOGRAM_SUB_BUCKETS)
+		return ((int) us);
+	shift = 63 - __builtin_clzll(us) - 4;
+	bucket = (shift + 1) * HISTOGRAM_SUB_BUCKETS +
+		(int) (us >> shift) - HISTOGRAM_SUB_BUCKETS;
+	return (bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1);
+}
+
+/**
+ * bucketValue - Finds the smallest duration of a bucket
+ *
+ * @bucket: Index of the bucket
+ *
+ * Return: Duration in microseconds
+ */
+uint64_t LatencyHistogram::bucketValue(int bucket)
+{
+	int shift;
+
+	if (bucket < HISTOGRAM_SUB_BUCKETS)
+		return ((uint64_t) bucket);
+	shift = bucket / HISTOGRAM_SUB_BUCKETS - 1;
+	return ((uint64_t) (bucket % HISTOGRAM_SUB_BUCKETS +
+				HISTOGRAM_SUB_BUCKETS) << shift);
+}
+
+/**
+ * record - Adds a sample
+ *
+ * @us: Duration in microseconds
+ *
+ * Return: Nothing
+ */
+void LatencyHistogram::record(uint64_t us)
+{
+	m_buckets[bucketOf(us)]++;
+	m_count++;
+	m_total += us;
+	if (us > m_max)
+		m_max = us;
+}
+
+/**
+ * percentile - Finds the duration a share of the samples do not exceed
+ *
+ * @p: Share of the samples, between 0 and 100
+ *
+ * Return: Duration in microseconds, 0 without samples
+ */
+uint64_t LatencyHistogram::percentile(double p) const
+{
+	uint64_t rank, seen;
+
+	if (m_count == 0)
+		return (0);
+	rank = (uint64_t) (p / 100.0 * m_count + 0.5);
+	if (rank < 1)
+		rank = 1;
+	seen = 0;
+	for (int i = 0; i < HISTOGRAM_BUCKETS; i++)
+	{
+		seen += m_buckets[i];
+		if (seen >= rank)
+			return (bucketValue(i) < m_max ? bucketValue(i) : m_max);
+	}
+	return (m_max);
+}
+
+/**
+ * metricName - Names a Metric for the HUD and the CSV
+ *
+ * @metric: Metric to name
+ *
+ * Return: Name of the metric
+ */
+const char *metricName(int metric)
+{
+	static const char *const names[METRIC_COUNT] = {
+		"event", "highlight", "move", "draw"
+	};
+
+	return (names[metric]);
+}
+
+/**
+ * dumpMetrics - Writes the histograms and counters as CSV, one row each
+ *
+ * @path: File to write
+ *
+ * Return: true on success, Otherwise false
+ */
+bool dumpMetrics(const char *path)
+{
+	FILE *file;
+
+	file = fopen(path, "w");
+	if (file == nullptr)
+	{
+		fprintf(stderr, "Unable to write %s\n", path);
+		return (false);
+	}
+	fprintf(file, "metric,count,mean_us,p50_us,p95_us,p99_us,max_us\n");
+	for (int i = 0; i < METRIC_COUNT; i++)
+	{
+		const LatencyHistogram &h = metrics.histograms[i];
+
+		fprintf(file, "%s,%llu,%llu,%llu,%llu,%llu,%llu\n", metricName(i),
+				(unsigned long long) h.count(),
+				(unsigned long long) h.mean(),
+				(unsigned long long) h.percentile(50),
+				(unsigned long long) h.percentile(95),
+				(unsigned long long) h.percentile(99),
+				(unsigned long long) h.max());
+	}
+	fprintf(file, "frames,%llu,,,,,\n", (unsigned long long) metrics.frames);
+	fprintf(file, "textures,%llu,,,,,\n",
+			(unsigned long long) metrics.textures);
+	fclose(file);
+	return (true);
+}
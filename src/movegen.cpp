@@ -0,0 +1,252 @@
+#include "../headers/position.h"
+
+/**
+ * checkers - Finds the pieces giving check to the side to move
+ *
+ * Return: Bitboard of the checking pieces
+ */
+Bitboard Position::checkers(void) const
+{
+	int ksq;
+
+	ksq = kingSquare(m_black_turn);
+	if (ksq == NO_SQUARE)
+		return (0);
+	return (attackersTo(ksq, m_occupied) & m_colors[!m_black_turn]);
+}
+
+/**
+ * pinnedPieces - Finds the pieces of one color that shield their king from
+ * an opposing rook, bishop or queen
+ *
+ * @black: Color of the king to look at
+ *
+ * Return: Bitboard of the pinned pieces
+ */
+Bitboard Position::pinnedPieces(bool black) const
+{
+	Bitboard snipers, pinned;
+	int ksq;
+
+	ksq = kingSquare(black);
+	if (ksq == NO_SQUARE)
+		return (0);
+	snipers = ((rookAttacks(ksq, 0) & (m_pieces[!black][ROOK] |
+					m_pieces[!black][QUEEN])) |
+			(bishopAttacks(ksq, 0) & (m_pieces[!black][BISHOP] |
+					m_pieces[!black][QUEEN])));
+	pinned = 0;
+	while (snipers)
+	{
+		Bitboard blockers;
+
+		blockers = betweenBits(ksq, popLsb(snipers)) & m_occupied;
+		if (blockers && !(blockers & (blockers - 1)))
+			pinned |= blockers & m_colors[black];
+	}
+	return (pinned);
+}
+
+/**
+ * addPawnMoves - Adds a pawn move, expanded into the four promotions when
+ * the pawn reaches the last rank
+ *
+ * @list: List to add the move(s) to
+ * @from: Origin grid of the pawn
+ * @to: Destination grid of the pawn
+ * @flags: QUIET_MOVE or CAPTURE_MOVE
+ *
+ * Return: Nothing
+ */
+void Position::addPawnMoves(MoveList &list, int from, int to, int flags) const
+{
+	if (squareY(to) == 0 || squareY(to) == 7)
+	{
+		list.add(CompactMove(from, to, flags | QUEEN_PROMOTION));
+		list.add(CompactMove(from, to, flags | ROOK_PROMOTION));
+		list.add(CompactMove(from, to, flags | BISHOP_PROMOTION));
+		list.add(CompactMove(from, to, flags | KNIGHT_PROMOTION));
+	} else
+		list.add(CompactMove(from, to, flags));
+}
+
+/**
+ * addCastling - Adds the castling moves of the side to move. The king must
+ * not be in check, nor cross or land on an attacked grid
+ *
+ * @list: List to add the move(s) to
+ * @ksq: Grid of the king, on its home grid whenever a right is left
+ *
+ * Return: Nothing
+ */
+void Position::addCastling(MoveList &list, int ksq) const
+{
+	int king_side, queen_side;
+	bool them;
+
+	if (ksq != square(3, m_black_turn ? 7 : 0))
+		return;
+	them = !m_black_turn;
+	king_side = m_black_turn ? BLACK_KING_SIDE : WHITE_KING_SIDE;
+	queen_side = m_black_turn ? BLACK_QUEEN_SIDE : WHITE_QUEEN_SIDE;
+
+	// King side: the rook sits on x = 0, the king lands on x = 1
+	if ((m_castling & king_side) &&
+			(m_pieces[m_black_turn][ROOK] & squareBit(ksq - 3)) &&
+			!(m_occupied & (squareBit(ksq - 1) | squareBit(ksq - 2))) &&
+			!isAttacked(ksq - 1, them) && !isAttacked(ksq - 2, them))
+		list.add(CompactMove(ksq, ksq - 2, KING_SIDE_CASTLE));
+
+	// Queen side: the rook sits on x = 7, the king lands on x = 5
+	if ((m_castling & queen_side) &&
+			(m_pieces[m_black_turn][ROOK] & squareBit(ksq + 4)) &&
+			!(m_occupied & (squareBit(ksq + 1) | squareBit(ksq + 2) |
+					squareBit(ksq + 3))) &&
+			!isAttacked(ksq + 1, them) && !isAttacked(ksq + 2, them))
+		list.add(CompactMove(ksq, ksq + 2, QUEEN_SIDE_CASTLE));
+}
+
+/**
+ * generateLegalMoves - Fills list with every legal move of the side to move,
+ * castling, en passant and promotions included. Pins and checks are resolved
+ * up front from the bitboards, so no move is ever played to test it
+ *
+ * @list: List to fill, cleared first
+ *
+ * Return: Nothing
+ */
+void Position::generateLegalMoves(MoveList &list) const
+{
+	Bitboard own, enemy, checking, pinned, targets, bb;
+	bool us, them;
+	int ksq, push;
+
+	list.clear();
+	us = m_black_turn;
+	them = !us;
+	ksq = kingSquare(us);
+	if (ksq == NO_SQUARE)
+		return;
+	own = m_colors[us];
+	enemy = m_colors[them];
+	checking = checkers();
+
+	// King moves, with the king lifted off the board so sliders see through
+	bb = kingAttacks(ksq) & ~own;
+	while (bb)
+	{
+		int to;
+
+		to = popLsb(bb);
+		if (!isAttacked(to, them, m_occupied ^ squareBit(ksq)))
+			list.add(CompactMove(ksq, to, (enemy & squareBit(to)) ?
+						CAPTURE_MOVE : QUIET_MOVE));
+	}
+
+	// Only the king may move out of a double check
+	if (checking & (checking - 1))
+		return;
+
+	// Grids the other pieces may move to: anywhere not held by their own
+	// side, or onto the checker / between it and the king when in check
+	if (checking)
+		targets = checking | betweenBits(ksq, lsb(checking));
+	else
+	{
+		targets = ~own;
+		addCastling(list, ksq);
+	}
+	pinned = pinnedPieces(us);
+
+	for (int type = QUEEN; type <= KNIGHT; type++)
+	{
+		Bitboard pieces;
+
+		pieces = m_pieces[us][type];
+		while (pieces)
+		{
+			int from;
+
+			from = popLsb(pieces);
+			switch (type)
+			{
+				case QUEEN:
+					bb = queenAttacks(from, m_occupied);
+					break;
+				case ROOK:
+					bb = rookAttacks(from, m_occupied);
+					break;
+				case BISHOP:
+					bb = bishopAttacks(from, m_occupied);
+					break;
+				default:
+					bb = knightAttacks(from);
+					break;
+			}
+			bb &= targets & ~own;
+			if (pinned & squareBit(from))
+				bb &= lineBits(ksq, from);
+			while (bb)
+			{
+				int to;
+
+				to = popLsb(bb);
+				list.add(CompactMove(from, to, (enemy & squareBit(to)) ?
+							CAPTURE_MOVE : QUIET_MOVE));
+			}
+		}
+	}
+
+	// Pawns: white advance up the board (+8), black down (-8)
+	push = us ? -8 : 8;
+	bb = m_pieces[us][PAWN];
+	while (bb)
+	{
+		Bitboard moves, captures;
+		int from, to;
+
+		from = popLsb(bb);
+		moves = 0;
+		to = from + push;
+		if (!(m_occupied & squareBit(to)))
+		{
+			moves |= squareBit(to);
+			if (squareY(from) == (us ? 6 : 1) &&
+					!(m_occupied & squareBit(to + push)))
+				moves |= squareBit(to + push);
+		}
+		captures = pawnAttacks(from, us) & enemy;
+		moves &= targets;
+		captures &= targets;
+		if (pinned & squareBit(from))
+		{
+			moves &= lineBits(ksq, from);
+			captures &= lineBits(ksq, from);
+		}
+		while (moves)
+		{
+			to = popLsb(moves);
+			if (to == from + 2 * push)
+				list.add(CompactMove(from, to, DOUBLE_PUSH));
+			else
+				addPawnMoves(list, from, to, QUIET_MOVE);
+		}
+		while (captures)
+			addPawnMoves(list, from, popLsb(captures), CAPTURE_MOVE);
+
+		// En passant clears two grids of the same rank at once, so check the
+		// king against the resulting occupancy rather than the pin masks
+		if (m_ep_square != NO_SQUARE &&
+				(pawnAttacks(from, us) & squareBit(m_ep_square)))
+		{
+			Bitboard occupied;
+			int captured;
+
+			captured = m_ep_square - push;
+			occupied = (m_occupied ^ squareBit(from) ^ squareBit(captured)) |
+				squareBit(m_ep_square);
+			if (!(attackersTo(ksq, occupied) & enemy & ~squareBit(captured)))
+				list.add(CompactMove(from, m_ep_square, EN_PASSANT));
+		}
+	}
+}
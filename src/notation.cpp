@@ -0,0 +1,414 @@
+#include "../headers/position.h"
+#include <string.h>
+
+/**
+ * pieceFromChar - Maps a FEN piece letter onto its type and color
+ *
+ * @c: FEN letter, upper case for white
+ * @black: Set to whether or not the piece is black
+ *
+ * Return: Type of the piece, NONE if c is not a piece letter
+ */
+static PieceType pieceFromChar(char c, bool *black)
+{
+	*black = c >= 'a' && c <= 'z';
+	switch (*black ? c - 'a' + 'A' : c)
+	{
+		case 'K':
+			return (KING);
+		case 'Q':
+			return (QUEEN);
+		case 'R':
+			return (ROOK);
+		case 'B':
+			return (BISHOP);
+		case 'N':
+			return (KNIGHT);
+		case 'P':
+			return (PAWN);
+		default:
+			return (NONE);
+	}
+}
+
+/**
+ * parseSquare - Reads an algebraic grid name such as "e3". Files run from
+ * 'a' at x = 7 to 'h' at x = 0 and rank 1 is y = 0
+ *
+ * @s: Text to read two characters from
+ *
+ * Return: The grid, NO_SQUARE if s does not name one
+ */
+static int parseSquare(const char *s)
+{
+	if (s[0] < 'a' || s[0] > 'h' || s[1] < '1' || s[1] > '8')
+		return (NO_SQUARE);
+	return (square(7 - (s[0] - 'a'), s[1] - '1'));
+}
+
+/**
+ * parseNumber - Reads a non-negative decimal number
+ *
+ * @s: Pointer to the text, advanced past the digits read
+ * @value: Set to the number read
+ *
+ * Return: true if at least one digit was read, false otherwise
+ */
+static bool parseNumber(const char **s, int *value)
+{
+	if (**s < '0' || **s > '9')
+		return (false);
+	*value = 0;
+	while (**s >= '0' && **s <= '9')
+		*value = *value * 10 + (*(*s)++ - '0');
+	return (true);
+}
+
+/**
+ * setFen - Sets up the position described by a FEN string. The text is read
+ * in place, nothing is allocated. The halfmove clock and fullmove number
+ * fields are optional
+ *
+ * @fen: FEN string to parse
+ *
+ * Return: true on success, false if fen is malformed or describes an
+ * impossible position, in which case the position is left cleared
+ */
+bool Position::setFen(const char *fen)
+{
+	int x, y, clock, fullmove, ep;
+	bool black;
+
+	clear();
+	while (*fen == ' ')
+		fen++;
+
+	// Piece placement, from rank 8 down to rank 1, file a (x = 7) first
+	for (x = 7, y = 7; *fen && *fen != ' '; fen++)
+	{
+		PieceType type;
+
+		if (*fen == '/')
+		{
+			if (x != -1 || y == 0)
+				break;
+			x = 7;
+			y--;
+		} else if (*fen >= '1' && *fen <= '8')
+			x -= *fen - '0';
+		else
+		{
+			type = pieceFromChar(*fen, &black);
+			if (type == NONE || x < 0 ||
+					(type == PAWN && (y == 0 || y == 7)))
+				break;
+			putPiece(square(x--, y), type, black);
+		}
+		if (x < -1)
+			break;
+	}
+	if (*fen != ' ' || x != -1 || y != 0 ||
+			popCount(m_pieces[0][KING]) != 1 ||
+			popCount(m_pieces[1][KING]) != 1)
+	{
+		clear();
+		return (false);
+	}
+
+	// Side to move
+	fen++;
+	if (*fen != 'w' && *fen != 'b')
+	{
+		clear();
+		return (false);
+	}
+	if (*fen++ == 'b')
+		flipTurn();
+	while (*fen == ' ')
+		fen++;
+
+	// Castling rights, kept only when the king and rook are still home
+	for (; *fen && *fen != ' '; fen++)
+	{
+		switch (*fen)
+		{
+			case 'K':
+				setCastlingRights(m_castling | WHITE_KING_SIDE);
+				break;
+			case 'Q':
+				setCastlingRights(m_castling | WHITE_QUEEN_SIDE);
+				break;
+			case 'k':
+				setCastlingRights(m_castling | BLACK_KING_SIDE);
+				break;
+			case 'q':
+				setCastlingRights(m_castling | BLACK_QUEEN_SIDE);
+				break;
+			default:
+				break;
+		}
+	}
+	for (int c = 0; c < 2; c++)
+	{
+		int home;
+
+		home = c ? 56 : 0;
+		if (!(m_pieces[c][KING] & squareBit(home + 3)))
+			updateCastlingRights(home + 3, home + 3);
+		if (!(m_pieces[c][ROOK] & squareBit(home)))
+			updateCastlingRights(home, home);
+		if (!(m_pieces[c][ROOK] & squareBit(home + 7)))
+			updateCastlingRights(home + 7, home + 7);
+	}
+	while (*fen == ' ')
+		fen++;
+
+	// En passant grid, dropped unless a pawn could have just double pushed
+	// and one of ours is there to take it, as makeMove does
+	ep = parseSquare(fen);
+	if (ep != NO_SQUARE && squareY(ep) == (m_black_turn ? 2 : 5) &&
+			(m_pieces[!m_black_turn][PAWN] &
+			 squareBit(ep + (m_black_turn ? 8 : -8))) &&
+			(pawnAttacks(ep, !m_black_turn) & m_pieces[m_black_turn][PAWN]))
+		setEnPassantSquare(ep);
+	while (*fen && *fen != ' ')
+		fen++;
+	while (*fen == ' ')
+		fen++;
+
+	if (parseNumber(&fen, &clock))
+		m_halfmove_clock = clock;
+	while (*fen == ' ')
+		fen++;
+	if (parseNumber(&fen, &fullmove) && fullmove > 0)
+		m_fullmove = fullmove;
+	return (true);
+}
+
+/**
+ * writeNumber - Writes a non-negative decimal number
+ *
+ * @out: Buffer to write to
+ * @value: Number to write
+ *
+ * Return: Number of characters written
+ */
+static int writeNumber(char *out, int value)
+{
+	char digits[10];
+	int count, len;
+
+	count = 0;
+	do {
+		digits[count++] = '0' + value % 10;
+		value /= 10;
+	} while (value);
+	for (len = 0; len < count; len++)
+		out[len] = digits[count - 1 - len];
+	return (len);
+}
+
+/**
+ * getFen - Writes the FEN string of the position, without allocating. The
+ * en passant grid only shows when a capture is possible there, as setFen
+ * and makeMove keep it
+ *
+ * @out: Buffer of at least MAX_FEN_LENGTH characters
+ *
+ * Return: Length of the FEN written, null byte excluded
+ */
+int Position::getFen(char *out) const
+{
+	static const char letters[6] = { 'k', 'q', 'r', 'b', 'n', 'p' };
+	int len;
+
+	len = 0;
+	for (int y = 7; y >= 0; y--)
+	{
+		int empty;
+
+		empty = 0;
+		for (int x = 7; x >= 0; x--)
+		{
+			char letter;
+			int sq;
+
+			sq = square(x, y);
+			if (isEmpty(sq))
+			{
+				empty++;
+				continue;
+			}
+			if (empty)
+				out[len++] = '0' + empty;
+			empty = 0;
+			letter = letters[pieceType(sq)];
+			out[len++] = isBlack(sq) ? letter : letter - 'a' + 'A';
+		}
+		if (empty)
+			out[len++] = '0' + empty;
+		if (y)
+			out[len++] = '/';
+	}
+
+	out[len++] = ' ';
+	out[len++] = m_black_turn ? 'b' : 'w';
+	out[len++] = ' ';
+	if (m_castling & WHITE_KING_SIDE)
+		out[len++] = 'K';
+	if (m_castling & WHITE_QUEEN_SIDE)
+		out[len++] = 'Q';
+	if (m_castling & BLACK_KING_SIDE)
+		out[len++] = 'k';
+	if (m_castling & BLACK_QUEEN_SIDE)
+		out[len++] = 'q';
+	if (m_castling == 0)
+		out[len++] = '-';
+
+	out[len++] = ' ';
+	if (m_ep_square != NO_SQUARE)
+	{
+		squareName(m_ep_square, out + len);
+		len += 2;
+	} else
+		out[len++] = '-';
+
+	out[len++] = ' ';
+	len += writeNumber(out + len, m_halfmove_clock);
+	out[len++] = ' ';
+	len += writeNumber(out + len, m_fullmove);
+	out[len] = '\0';
+	return (len);
+}
+
+/**
+ * squareName - Writes the algebraic name of a grid, e.g. "e4"
+ *
+ * @sq: Grid to name
+ * @out: Buffer of at least 3 characters
+ *
+ * Return: Nothing
+ */
+void squareName(int sq, char *out)
+{
+	out[0] = 'a' + (7 - squareX(sq));
+	out[1] = '1' + squareY(sq);
+	out[2] = '\0';
+}
+
+/**
+ * moveName - Writes a move in coordinate notation, e.g. "e2e4" or "a7a8q"
+ *
+ * @move: Move to name
+ * @out: Buffer of at least 6 characters
+ *
+ * Return: Nothing
+ */
+void moveName(CompactMove move, char *out)
+{
+	static const char promotion[4] = { 'n', 'b', 'r', 'q' };
+
+	squareName(move.from(), out);
+	squareName(move.to(), out + 2);
+	if (move.isPromotion())
+	{
+		out[4] = promotion[move.flags() & 3];
+		out[5] = '\0';
+	}
+}
+
+/**
+ * parseSan - Finds the legal move a SAN token such as "Nbd7", "exd8=Q+" or
+ * "O-O" stands for, by matching it against the legal moves. Check, mate and
+ * annotation marks after the move are ignored
+ *
+ * @san: SAN token, not necessarily null terminated
+ * @len: Length of the token
+ *
+ * Return: The move, a null move if san is malformed, illegal or ambiguous
+ */
+CompactMove Position::parseSan(const char *san, int len) const
+{
+	MoveList list;
+	CompactMove found;
+	PieceType type, promotion;
+	int to, file, rank, matches;
+	bool black;
+
+	found = CompactMove(0, 0, QUIET_MOVE);
+	while (len > 0 && strchr("+#!?", san[len - 1]))
+		len--;
+	generateLegalMoves(list);
+
+	// Castling, also written with zeros
+	if (san[0] == 'O' || san[0] == '0')
+	{
+		int flags;
+
+		if (len == 5 && san[1] == '-' && san[3] == '-' && san[2] == san[0] &&
+				san[4] == san[0])
+			flags = QUEEN_SIDE_CASTLE;
+		else if (len == 3 && san[1] == '-' && san[2] == san[0])
+			flags = KING_SIDE_CASTLE;
+		else
+			return (found);
+		for (int i = 0; i < list.size(); i++)
+		{
+			if (list[i].flags() == flags)
+				return (list[i]);
+		}
+		return (found);
+	}
+
+	// An upper case letter names the piece, pawns go without one
+	type = PAWN;
+	if (len > 0 && san[0] >= 'A' && san[0] <= 'Z')
+	{
+		type = pieceFromChar(san[0], &black);
+		if (type == NONE)
+			return (found);
+		san++;
+		len--;
+	}
+	promotion = NONE;
+	if (len > 2 && san[len - 1] >= 'A' && san[len - 1] <= 'Z')
+	{
+		promotion = pieceFromChar(san[len - 1], &black);
+		if (promotion == NONE || promotion == KING || promotion == PAWN)
+			return (found);
+		len--;
+		if (san[len - 1] == '=')
+			len--;
+	}
+	if (len < 2 || (to = parseSquare(san + len - 2)) == NO_SQUARE)
+		return (found);
+
+	// Whatever comes before the destination narrows down the origin
+	file = -1;
+	rank = -1;
+	for (int i = 0; i < len - 2; i++)
+	{
+		if (san[i] >= 'a' && san[i] <= 'h')
+			file = 7 - (san[i] - 'a');
+		else if (san[i] >= '1' && san[i] <= '8')
+			rank = san[i] - '1';
+		else if (san[i] != 'x' && san[i] != '-')
+			return (found);
+	}
+
+	matches = 0;
+	for (int i = 0; i < list.size(); i++)
+	{
+		CompactMove move;
+
+		move = list[i];
+		if (move.to() != to || pieceType(move.from()) != type ||
+				move.isCastling() || move.promotion() != promotion ||
+				(file >= 0 && squareX(move.from()) != file) ||
+				(rank >= 0 && squareY(move.from()) != rank))
+			continue;
+		found = move;
+		matches++;
+	}
+	return (matches == 1 ? found : CompactMove(0, 0, QUIET_MOVE));
+}
@@ -1,19 +1,16 @@
 #include "../headers/pieces.h"
 #include "../headers/game.h"
 
-Pawn::Pawn(int x, int y, bool isBlack, SDL_Renderer* renderer,
-		ChessBoard* board)
-	: Piece(x, y, isBlack, renderer, board)
+Pawn::Pawn(int x, int y, bool isBlack, ChessBoard* board)
+	: Piece(x, y, isBlack, board)
 {
 	piece_type = PieceType::PAWN;
 	if (isBlack)
 	{
-		piece_texture = loadImage("assets/black_pawn.png",
-				renderer);
+		sprite = BLACK_PAWN_SPRITE;
 	} else
 	{
-		piece_texture = loadImage("assets/white_pawn.png",
-				renderer);
+		sprite = WHITE_PAWN_SPRITE;
 	}
 }
 
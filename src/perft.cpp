@@ -0,0 +1,346 @@
+#include "../headers/perft.h"
+#include <deque>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+// Tasks are split down to this many plies below the root before counting
+const int SPLIT_PLY = 2;
+
+/**
+ * perft - Counts the leaf nodes of the legal move tree down to a depth, the
+ * standard way to check a move generator against known results. The last
+ * ply is bulk counted from the size of the move list
+ *
+ * @pos: Position to count from, restored before returning
+ * @depth: Number of plies to walk
+ *
+ * Return: Number of leaf nodes
+ */
+uint64_t perft(Position &pos, int depth)
+{
+	MoveList list;
+	uint64_t nodes;
+
+	if (depth <= 0)
+		return (1);
+#ifdef DEBUG_ZOBRIST
+	if (!pos.keyIsValid())
+	{
+		fprintf(stderr, "Zobrist key mismatch at depth %d\n", depth);
+		abort();
+	}
+#endif
+	pos.generateLegalMoves(list);
+	if (depth == 1)
+		return (list.size());
+
+	nodes = 0;
+	for (int i = 0; i < list.size(); i++)
+	{
+		pos.makeMove(list[i]);
+		nodes += perft(pos, depth - 1);
+		pos.unmakeMove();
+	}
+	return (nodes);
+}
+
+/**
+ * PerftTable - Allocates a cleared table
+ *
+ * @megabytes: Memory to use, rounded down to a power of two entries
+ *
+ * Return: Nothing
+ */
+PerftTable::PerftTable(size_t megabytes)
+{
+	size_t entries;
+
+	entries = 1;
+	while (entries * 2 * 16 <= megabytes * 1024 * 1024)
+		entries *= 2;
+	m_mask = entries - 1;
+	m_slots = new std::atomic<uint64_t>[entries * 2];
+	for (size_t i = 0; i < entries * 2; i++)
+		m_slots[i].store(0, std::memory_order_relaxed);
+}
+
+PerftTable::~PerftTable(void)
+{
+	delete[] m_slots;
+}
+
+/**
+ * probe - Looks up the node count of a subtree
+ *
+ * @key: Zobrist key of the subtree root
+ * @depth: Depth the subtree was counted to
+ * @nodes: Set to the node count on a hit
+ *
+ * Return: true on a hit, false otherwise
+ */
+bool PerftTable::probe(uint64_t key, int depth, uint64_t *nodes) const
+{
+	uint64_t check, data;
+	size_t i;
+
+	i = (key & m_mask) * 2;
+	check = m_slots[i].load(std::memory_order_relaxed);
+	data = m_slots[i + 1].load(std::memory_order_relaxed);
+	if ((check ^ data) != key || (int) (data & 0xff) != depth)
+		return (false);
+	*nodes = data >> 8;
+	return (true);
+}
+
+/**
+ * store - Records the node count of a subtree, replacing the previous entry
+ *
+ * @key: Zobrist key of the subtree root
+ * @depth: Depth the subtree was counted to
+ * @nodes: Node count of the subtree
+ *
+ * Return: Nothing
+ */
+void PerftTable::store(uint64_t key, int depth, uint64_t nodes)
+{
+	uint64_t data;
+	size_t i;
+
+	i = (key & m_mask) * 2;
+	data = (nodes << 8) | (uint64_t) depth;
+	m_slots[i].store(key ^ data, std::memory_order_relaxed);
+	m_slots[i + 1].store(data, std::memory_order_relaxed);
+}
+
+/**
+ * perftHashed - perft that reuses the node counts of subtrees it, or another
+ * thread, has already counted
+ *
+ * @pos: Position to count from, restored before returning
+ * @depth: Number of plies to walk
+ * @table: Shared node count cache, plain perft is used when nullptr
+ *
+ * Return: Number of leaf nodes
+ */
+uint64_t perftHashed(Position &pos, int depth, PerftTable *table)
+{
+	MoveList list;
+	uint64_t key, nodes;
+
+	if (!table || depth <= 1)
+		return (perft(pos, depth));
+	key = pos.key();
+	if (table->probe(key, depth, &nodes))
+		return (nodes);
+
+	pos.generateLegalMoves(list);
+	nodes = 0;
+	for (int i = 0; i < list.size(); i++)
+	{
+		pos.makeMove(list[i]);
+		nodes += perftHashed(pos, depth - 1, table);
+		pos.unmakeMove();
+	}
+	table->store(key, depth, nodes);
+	return (nodes);
+}
+
+/**
+ * struct PerftTask - A subtree to count, given as the moves leading to it
+ *
+ * @path: Moves from the root position
+ * @length: Number of moves in path
+ * @root: Index of the root move the subtree belongs to
+ */
+struct PerftTask
+{
+	CompactMove path[SPLIT_PLY];
+	int length;
+	int root;
+};
+
+/**
+ * TaskQueue - Double ended queue of tasks owned by one worker. The owner
+ * works from the back, idle workers steal from the front
+ *
+ * @m_lock: Guards m_tasks
+ * @m_tasks: Pending tasks
+ */
+class TaskQueue {
+private:
+	std::mutex m_lock;
+	std::deque<PerftTask> m_tasks;
+
+public:
+	void push(const PerftTask &task)
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+
+		m_tasks.push_back(task);
+	};
+
+	bool pop(PerftTask *task)
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+
+		if (m_tasks.empty())
+			return (false);
+		*task = m_tasks.back();
+		m_tasks.pop_back();
+		return (true);
+	};
+
+	bool steal(PerftTask *task)
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+
+		if (m_tasks.empty())
+			return (false);
+		*task = m_tasks.front();
+		m_tasks.pop_front();
+		return (true);
+	};
+};
+
+/**
+ * struct PerftJob - State shared by the workers of one parallelPerft call
+ *
+ * @root: Position the count starts from
+ * @depth: Depth to count to from the root
+ * @table: Shared node count cache, may be nullptr
+ * @queues: One task queue per worker
+ * @workers: Number of workers
+ * @pending: Tasks queued or running, the workers stop when it reaches 0
+ * @root_nodes: Node count accumulated per root move
+ */
+struct PerftJob
+{
+	const Position *root;
+	int depth;
+	PerftTable *table;
+	TaskQueue *queues;
+	int workers;
+	std::atomic<int> pending;
+	std::atomic<uint64_t> root_nodes[MAX_MOVES];
+};
+
+/**
+ * perftWorker - Runs tasks from its own queue, stealing from the other
+ * workers once it runs dry, until no task is left anywhere. Shallow tasks
+ * are split into one task per move so deep subtrees spread over the pool
+ *
+ * @job: Shared job state
+ * @id: Index of the worker, and of its queue
+ *
+ * Return: Nothing
+ */
+static void perftWorker(PerftJob *job, int id)
+{
+	Position pos(*job->root);
+	PerftTask task;
+
+	while (job->pending.load() > 0)
+	{
+		bool found;
+		int remaining;
+
+		found = job->queues[id].pop(&task);
+		for (int i = 1; !found && i < job->workers; i++)
+			found = job->queues[(id + i) % job->workers].steal(&task);
+		if (!found)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		for (int i = 0; i < task.length; i++)
+			pos.makeMove(task.path[i]);
+		remaining = job->depth - task.length;
+		if (task.length < SPLIT_PLY && remaining > 2)
+		{
+			MoveList list;
+
+			pos.generateLegalMoves(list);
+			job->pending += list.size();
+			for (int i = 0; i < list.size(); i++)
+			{
+				PerftTask child;
+
+				child = task;
+				child.path[child.length++] = list[i];
+				job->queues[id].push(child);
+			}
+		} else
+			job->root_nodes[task.root] += perftHashed(pos, remaining,
+					job->table);
+		for (int i = 0; i < task.length; i++)
+			pos.unmakeMove();
+		job->pending--;
+	}
+}
+
+/**
+ * parallelPerft - Counts leaf nodes like perft with a pool of threads. Root
+ * moves and their replies become tasks balanced across the pool by work
+ * stealing, and subtree counts are shared through table
+ *
+ * @root: Position to count from
+ * @depth: Number of plies to walk
+ * @threads: Number of worker threads
+ * @table: Shared node count cache, may be nullptr
+ * @root_nodes: When not nullptr, receives the count below each root move in
+ * the order of root.generateLegalMoves
+ *
+ * Return: Number of leaf nodes
+ */
+uint64_t parallelPerft(const Position &root, int depth, int threads,
+		PerftTable *table, uint64_t *root_nodes)
+{
+	std::vector<std::thread> pool;
+	MoveList list;
+	PerftJob *job;
+	uint64_t total;
+
+	if (depth <= 0)
+		return (1);
+	if (threads < 1)
+		threads = 1;
+	root.generateLegalMoves(list);
+
+	job = new PerftJob();
+	job->root = &root;
+	job->depth = depth;
+	job->table = table;
+	job->queues = new TaskQueue[threads];
+	job->workers = threads;
+	job->pending = list.size();
+	for (int i = 0; i < list.size(); i++)
+	{
+		PerftTask task;
+
+		task.path[0] = list[i];
+		task.length = 1;
+		task.root = i;
+		job->root_nodes[i] = 0;
+		job->queues[i % threads].push(task);
+	}
+
+	for (int i = 0; i < threads; i++)
+		pool.push_back(std::thread(perftWorker, job, i));
+	for (size_t i = 0; i < pool.size(); i++)
+		pool[i].join();
+
+	total = 0;
+	for (int i = 0; i < list.size(); i++)
+	{
+		total += job->root_nodes[i];
+		if (root_nodes)
+			root_nodes[i] = job->root_nodes[i];
+	}
+	delete[] job->queues;
+	delete job;
+	return (total);
+}
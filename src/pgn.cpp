@@ -0,0 +1,303 @@
+#include "../headers/pgn.h"
+#include <string.h>
+
+PgnReader::PgnReader(FILE *file)
+{
+	m_file = file;
+	m_pos = 0;
+	m_end = 0;
+	m_line_start = true;
+	m_bytes = 0;
+	m_games = 0;
+	m_moves = 0;
+	m_errors = 0;
+}
+
+/**
+ * fill - Reads the next chunk of the file into m_buffer
+ *
+ * Return: true if anything was read, false at the end of the file
+ */
+bool PgnReader::fill(void)
+{
+	m_pos = 0;
+	m_end = (int) fread(m_buffer, 1, sizeof(m_buffer), m_file);
+	m_bytes += m_end;
+	return (m_end > 0);
+}
+
+/**
+ * skipUntil - Skips characters up to and including a closing character
+ *
+ * @close: Character to stop after
+ *
+ * Return: Nothing
+ */
+void PgnReader::skipUntil(int close)
+{
+	int c;
+
+	do {
+		c = get();
+	} while (c != close && c != EOF);
+}
+
+/**
+ * skipVariation - Skips a variation, the opening '(' already read, along
+ * with the variations and comments nested in it
+ *
+ * Return: Nothing
+ */
+void PgnReader::skipVariation(void)
+{
+	int c, depth;
+
+	depth = 1;
+	while (depth > 0 && (c = get()) != EOF)
+	{
+		if (c == '(')
+			depth++;
+		else if (c == ')')
+			depth--;
+		else if (c == '{')
+			skipUntil('}');
+		else if (c == ';')
+			skipUntil('\n');
+	}
+}
+
+/**
+ * copyTag - Copies a tag value, cutting it short to fit
+ *
+ * @out: Tag buffer of PGN_TAG_LENGTH characters
+ * @value: Value read
+ * @len: Length of the value
+ *
+ * Return: Nothing
+ */
+static void copyTag(char *out, const char *value, int len)
+{
+	if (len > PGN_TAG_LENGTH - 1)
+		len = PGN_TAG_LENGTH - 1;
+	memcpy(out, value, len);
+	out[len] = '\0';
+}
+
+/**
+ * readTag - Reads a tag pair, the opening '[' already read, keeping the
+ * value of the tags PgnGame has room for. A FEN tag sets the game up
+ *
+ * @game: Game the tag belongs to
+ *
+ * Return: Nothing
+ */
+void PgnReader::readTag(PgnGame &game)
+{
+	char name[PGN_TAG_LENGTH], value[MAX_FEN_LENGTH];
+	int c, name_len, value_len;
+
+	while ((c = peek()) == ' ' || c == '\t')
+		get();
+	name_len = 0;
+	while ((c = peek()) != EOF && c != ' ' && c != '"' && c != ']' &&
+			c != '\n')
+	{
+		if (name_len < PGN_TAG_LENGTH - 1)
+			name[name_len++] = (char) c;
+		get();
+	}
+	name[name_len] = '\0';
+	while ((c = peek()) != EOF && c != '"' && c != ']' && c != '\n')
+		get();
+
+	// The value runs to the next unescaped quote
+	value_len = 0;
+	if (peek() == '"')
+	{
+		get();
+		while ((c = get()) != EOF && c != '"' && c != '\n')
+		{
+			if (c == '\\' && (peek() == '"' || peek() == '\\'))
+				c = get();
+			if (value_len < MAX_FEN_LENGTH - 1)
+				value[value_len++] = (char) c;
+		}
+	}
+	value[value_len] = '\0';
+	while ((c = peek()) != EOF && c != '\n' && get() != ']')
+		;
+
+	if (strcmp(name, "Event") == 0)
+		copyTag(game.event, value, value_len);
+	else if (strcmp(name, "Date") == 0)
+		copyTag(game.date, value, value_len);
+	else if (strcmp(name, "White") == 0)
+		copyTag(game.white, value, value_len);
+	else if (strcmp(name, "Black") == 0)
+		copyTag(game.black, value, value_len);
+	else if (strcmp(name, "Result") == 0)
+		copyTag(game.result, value, value_len);
+	else if (strcmp(name, "FEN") == 0)
+	{
+		memcpy(game.fen, value, value_len + 1);
+		if (!m_board.setFen(value))
+		{
+			game.error = true;
+			m_board.setFen(START_FEN);
+		}
+	}
+}
+
+/**
+ * readToken - Reads a movetext token, up to the next space or character
+ * that starts something else
+ *
+ * @out: Buffer the token is written to, null terminated
+ * @size: Size of out, longer tokens are cut short
+ *
+ * Return: Length of the token written
+ */
+int PgnReader::readToken(char *out, int size)
+{
+	int c, len;
+
+	len = 0;
+	while ((c = peek()) != EOF && !strchr(" \t\r\n{}();[]$", c))
+	{
+		if (len < size - 1)
+			out[len++] = (char) c;
+		get();
+	}
+	out[len] = '\0';
+	return (len);
+}
+
+/**
+ * playToken - Plays the move of a movetext token on m_board, after any move
+ * number. Nothing is played once the game had an error
+ *
+ * @game: Game the token belongs to
+ * @token: Token read
+ * @len: Length of the token
+ *
+ * Return: Nothing
+ */
+void PgnReader::playToken(PgnGame &game, const char *token, int len)
+{
+	CompactMove move;
+
+	// "12." and "12..." come before moves, "12.e4" sticks to one
+	if (token[0] >= '1' && token[0] <= '9')
+	{
+		while (len > 0 && *token >= '0' && *token <= '9')
+		{
+			token++;
+			len--;
+		}
+		while (len > 0 && *token == '.')
+		{
+			token++;
+			len--;
+		}
+	}
+	if (len == 0 || game.error)
+		return;
+
+	move = m_board.parseSan(token, len);
+	if (move.isNull() || game.move_count >= MAX_GAME_PLY)
+	{
+		game.error = true;
+		return;
+	}
+	m_board.makeMove(move);
+	game.moves[game.move_count++] = move;
+}
+
+/**
+ * next - Reads the next game of the file
+ *
+ * @game: Filled with the game read
+ *
+ * Return: true if a game was read, false at the end of the file
+ */
+bool PgnReader::next(PgnGame &game)
+{
+	char token[PGN_TOKEN_LENGTH];
+	int c, len;
+	bool started, in_moves, line_start;
+
+	game.event[0] = '\0';
+	game.date[0] = '\0';
+	game.white[0] = '\0';
+	game.black[0] = '\0';
+	game.result[0] = '\0';
+	game.fen[0] = '\0';
+	game.move_count = 0;
+	game.error = false;
+	m_board.setFen(START_FEN);
+	started = false;
+	in_moves = false;
+	while (true)
+	{
+		c = peek();
+		if (c == EOF)
+		{
+			if (!started)
+				return (false);
+			break;
+		}
+		if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+		{
+			get();
+			m_line_start = c == '\n';
+			continue;
+		}
+		started = true;
+
+		// Tags after the movetext belong to the next game, which lacked a
+		// result
+		if (c == '[' && in_moves)
+			break;
+		get();
+		line_start = m_line_start;
+		m_line_start = false;
+		if (c == '[')
+			readTag(game);
+		else if (c == '{')
+			skipUntil('}');
+		else if (c == ';' || (c == '%' && line_start))
+		{
+			// '%' only escapes a line in its first column, anywhere else
+			// it is read as part of a token
+			skipUntil('\n');
+			m_line_start = true;
+		} else if (c == '(')
+			skipVariation();
+		else if (c == '$')
+		{
+			while ((c = peek()) >= '0' && c <= '9')
+				get();
+		} else if (c == ')' || c == '}' || c == ']')
+			continue;
+		else
+		{
+			in_moves = true;
+			token[0] = (char) c;
+			len = 1 + readToken(token + 1, sizeof(token) - 1);
+			if (strcmp(token, "1-0") == 0 || strcmp(token, "0-1") == 0 ||
+					strcmp(token, "1/2-1/2") == 0 || strcmp(token, "*") == 0)
+			{
+				if (!game.result[0])
+					copyTag(game.result, token, len);
+				break;
+			}
+			playToken(game, token, len);
+		}
+	}
+
+	m_games++;
+	m_moves += game.move_count;
+	if (game.error)
+		m_errors++;
+	return (true);
+}
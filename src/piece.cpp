@@ -7,12 +7,11 @@
  * @x: Initial x position of the object
  * @y: Initial y position of the object
  * @isBlack: Is piece black or white
- * @renderer: Renderer for object to use to render itself
  * @board: Chess board the piece belongs to
  *
  * Return: Nothing
  */
-Piece::Piece(int x, int y, bool isBlack, SDL_Renderer* renderer, ChessBoard* board)
+Piece::Piece(int x, int y, bool isBlack, ChessBoard* board)
 {
 	this->x = x;
 	this->y = y;
@@ -59,7 +58,24 @@ bool Piece::operator==(const Piece* piece) const
 			piece_type == piece->getPieceType());
 }
 
-Piece::~Piece(void)
+/**
+ * isOpponent - Checks if a piece belongs to the other side
+ *
+ * @piece: Piece to compare colors with
+ *
+ * Return: true if piece is an opponent, false Otherwise
+ */
+bool Piece::isOpponent(const Piece* piece) const
+{
+	return (piece && piece->isBlack() != is_black);
+}
+
+/**
+ * isCovered - Checks if the piece is defended by its own side
+ *
+ * Return: true if a piece of the same color attacks its grid, false Otherwise
+ */
+bool Piece::isCovered(void)
 {
-	SDL_DestroyTexture(piece_texture);
+	return (m_board->isAttacked(x, y, is_black));
 }
@@ -0,0 +1,365 @@
+#include "../headers/position.h"
+#include "../headers/zobrist.h"
+#include <string.h>
+
+Position::Position(void)
+{
+	initAttackTables();
+	initZobrist();
+	m_undo.resize(MAX_GAME_PLY);
+	clear();
+}
+
+/**
+ * clear - Removes every piece from the position and hands the turn to white
+ *
+ * Return: Nothing
+ */
+void Position::clear(void)
+{
+	for (int c = 0; c < 2; c++)
+	{
+		for (int t = 0; t < 6; t++)
+			m_pieces[c][t] = 0;
+		m_colors[c] = 0;
+	}
+	m_occupied = 0;
+	for (int sq = 0; sq < 64; sq++)
+		m_mailbox[sq] = NONE;
+	m_black_turn = false;
+	m_castling = 0;
+	m_ep_square = NO_SQUARE;
+	m_halfmove_clock = 0;
+	m_fullmove = 1;
+	m_key = zobrist_castling[0];
+	m_undo_size = 0;
+}
+
+/**
+ * flipTurn - Hands the turn over to the other side
+ *
+ * Return: Nothing
+ */
+void Position::flipTurn(void)
+{
+	m_black_turn = !m_black_turn;
+	m_key ^= zobrist_black;
+}
+
+/**
+ * setCastlingRights - Replaces the castling rights of both sides
+ *
+ * @rights: CastlingRight bits now available
+ *
+ * Return: Nothing
+ */
+void Position::setCastlingRights(int rights)
+{
+	m_key ^= zobrist_castling[m_castling] ^ zobrist_castling[rights & 15];
+	m_castling = (uint8_t) (rights & 15);
+}
+
+/**
+ * setEnPassantSquare - Replaces the grid a pawn may capture en passant on
+ *
+ * @sq: New en passant grid, NO_SQUARE if none
+ *
+ * Return: Nothing
+ */
+void Position::setEnPassantSquare(int sq)
+{
+	if (m_ep_square != NO_SQUARE)
+		m_key ^= zobrist_ep[squareX(m_ep_square)];
+	m_ep_square = sq;
+	if (m_ep_square != NO_SQUARE)
+		m_key ^= zobrist_ep[squareX(m_ep_square)];
+}
+
+/**
+ * castlingLoss - Castling rights lost when a move touches a grid
+ *
+ * @sq: Grid touched as the origin or destination of a move
+ *
+ * Return: CastlingRight bits tied to the king or rook home grid sq
+ */
+static int castlingLoss(int sq)
+{
+	switch (sq)
+	{
+		case 3:
+			return (WHITE_KING_SIDE | WHITE_QUEEN_SIDE);
+		case 0:
+			return (WHITE_KING_SIDE);
+		case 7:
+			return (WHITE_QUEEN_SIDE);
+		case 59:
+			return (BLACK_KING_SIDE | BLACK_QUEEN_SIDE);
+		case 56:
+			return (BLACK_KING_SIDE);
+		case 63:
+			return (BLACK_QUEEN_SIDE);
+		default:
+			return (0);
+	}
+}
+
+/**
+ * updateCastlingRights - Drops the castling rights lost by a move touching
+ * the from and to grids, i.e. a king or rook leaving its home grid or a rook
+ * being captured on it
+ *
+ * @from: Origin grid of the move
+ * @to: Destination grid of the move
+ *
+ * Return: Nothing
+ */
+void Position::updateCastlingRights(int from, int to)
+{
+	setCastlingRights(m_castling & ~(castlingLoss(from) | castlingLoss(to)));
+}
+
+/**
+ * putPiece - Places a piece on an empty grid
+ *
+ * @sq: Grid to place the piece on
+ * @type: Type of the piece
+ * @black: Whether or not the piece is black
+ *
+ * Return: Nothing
+ */
+void Position::putPiece(int sq, PieceType type, bool black)
+{
+	Bitboard bit;
+
+	bit = squareBit(sq);
+	m_pieces[black][type] |= bit;
+	m_colors[black] |= bit;
+	m_occupied |= bit;
+	m_mailbox[sq] = type | (black << 3);
+	m_key ^= zobrist_pieces[black][type][sq];
+}
+
+/**
+ * removePiece - Removes the piece standing on a grid, if any
+ *
+ * @sq: Grid to clear
+ *
+ * Return: Nothing
+ */
+void Position::removePiece(int sq)
+{
+	Bitboard bit;
+	bool black;
+
+	if (isEmpty(sq))
+		return;
+	bit = squareBit(sq);
+	black = isBlack(sq);
+	m_key ^= zobrist_pieces[black][pieceType(sq)][sq];
+	m_pieces[black][pieceType(sq)] &= ~bit;
+	m_colors[black] &= ~bit;
+	m_occupied &= ~bit;
+	m_mailbox[sq] = NONE;
+}
+
+/**
+ * movePiece - Relocates the piece on from to the empty grid to
+ *
+ * @from: Grid the piece is standing on
+ * @to: Grid to move the piece to, any piece there must be removed first
+ *
+ * Return: Nothing
+ */
+void Position::movePiece(int from, int to)
+{
+	Bitboard from_to;
+	PieceType type;
+	bool black;
+
+	if (isEmpty(from))
+		return;
+	from_to = squareBit(from) | squareBit(to);
+	type = pieceType(from);
+	black = isBlack(from);
+	m_pieces[black][type] ^= from_to;
+	m_colors[black] ^= from_to;
+	m_occupied ^= from_to;
+	m_mailbox[to] = m_mailbox[from];
+	m_mailbox[from] = NONE;
+	m_key ^= zobrist_pieces[black][type][from] ^
+		zobrist_pieces[black][type][to];
+}
+
+/**
+ * attackersTo - Finds every piece, of either color, attacking a grid
+ *
+ * @sq: Grid under attack
+ * @occupied: Occupancy the sliding pieces should be blocked by
+ *
+ * Return: Bitboard of the attacking pieces
+ */
+Bitboard Position::attackersTo(int sq, Bitboard occupied) const
+{
+	Bitboard diagonal, straight;
+
+	diagonal = m_pieces[0][BISHOP] | m_pieces[1][BISHOP] |
+		m_pieces[0][QUEEN] | m_pieces[1][QUEEN];
+	straight = m_pieces[0][ROOK] | m_pieces[1][ROOK] |
+		m_pieces[0][QUEEN] | m_pieces[1][QUEEN];
+
+	return ((pawnAttacks(sq, true) & m_pieces[0][PAWN]) |
+			(pawnAttacks(sq, false) & m_pieces[1][PAWN]) |
+			(knightAttacks(sq) & (m_pieces[0][KNIGHT] | m_pieces[1][KNIGHT])) |
+			(kingAttacks(sq) & (m_pieces[0][KING] | m_pieces[1][KING])) |
+			(bishopAttacks(sq, occupied) & diagonal) |
+			(rookAttacks(sq, occupied) & straight));
+}
+
+/**
+ * isAttacked - Checks if any piece of one color attacks a grid
+ *
+ * @sq: Grid to check
+ * @by_black: Color of the attacking side
+ * @occupied: Occupancy the sliding pieces should be blocked by
+ *
+ * Return: true if the grid is attacked, false otherwise
+ */
+bool Position::isAttacked(int sq, bool by_black, Bitboard occupied) const
+{
+	const Bitboard *p;
+
+	p = m_pieces[by_black];
+	return ((pawnAttacks(sq, !by_black) & p[PAWN]) ||
+			(knightAttacks(sq) & p[KNIGHT]) ||
+			(kingAttacks(sq) & p[KING]) ||
+			(bishopAttacks(sq, occupied) & (p[BISHOP] | p[QUEEN])) ||
+			(rookAttacks(sq, occupied) & (p[ROOK] | p[QUEEN])));
+}
+
+/**
+ * firstBlocker - Finds the nearest piece standing strictly between two grids
+ * sharing a rank, file or diagonal
+ *
+ * @from: Grid the route starts from
+ * @to: Grid the route leads to
+ *
+ * Return: Grid of the blocking piece, NO_SQUARE if the route is clear
+ */
+int Position::firstBlocker(int from, int to) const
+{
+	Bitboard blockers;
+
+	blockers = betweenBits(from, to) & m_occupied;
+	if (!blockers)
+		return (NO_SQUARE);
+	return (to > from ? lsb(blockers) : msb(blockers));
+}
+
+/**
+ * computeKey - Computes the Zobrist hash of the position from scratch
+ *
+ * Return: 64-bit key identifying the position
+ */
+uint64_t Position::computeKey(void) const
+{
+	uint64_t key;
+
+	key = zobrist_castling[m_castling];
+	if (m_black_turn)
+		key ^= zobrist_black;
+	if (m_ep_square != NO_SQUARE)
+		key ^= zobrist_ep[squareX(m_ep_square)];
+	for (int c = 0; c < 2; c++)
+	{
+		for (int t = 0; t < 6; t++)
+		{
+			Bitboard bb;
+
+			bb = m_pieces[c][t];
+			while (bb)
+				key ^= zobrist_pieces[c][t][popLsb(bb)];
+		}
+	}
+	return (key);
+}
+
+/**
+ * trimHistory - Drops the oldest records of the move history, keeping the
+ * most recent ones
+ *
+ * @keep: Number of records to keep
+ *
+ * Return: Nothing
+ */
+void Position::trimHistory(int keep)
+{
+	if (keep < 0)
+		keep = 0;
+	if (keep >= m_undo_size)
+		return;
+	memmove(m_undo.data(), m_undo.data() + m_undo_size - keep,
+			keep * sizeof(UndoRecord));
+	m_undo_size = keep;
+}
+
+/**
+ * isRepetition - Checks whether the position already occurred a number of
+ * times, comparing Zobrist keys. A capture or pawn move can never be taken
+ * back, so only the records since the last one are scanned, and only every
+ * other one since the same side has to be to move
+ *
+ * @times: Earlier occurrences to look for
+ *
+ * Return: true if the position occurred at least times times before,
+ * false Otherwise
+ */
+bool Position::isRepetition(int times) const
+{
+	int end;
+
+	end = m_undo_size - m_halfmove_clock;
+	if (end < 0)
+		end = 0;
+
+	// Coming back to a position takes at least four plies
+	for (int i = m_undo_size - 4; i >= end; i -= 2)
+	{
+		if (m_undo[i].key == m_key && --times == 0)
+			return (true);
+	}
+	return (false);
+}
+
+/**
+ * isFiftyMoveDraw - Checks the fifty-move rule. Checkmate given on the
+ * hundredth ply still wins the game
+ *
+ * Return: true if a hundred plies went by without a capture or pawn move and
+ * the side to move is not mated, false otherwise
+ */
+bool Position::isFiftyMoveDraw(void) const
+{
+	MoveList list;
+
+	if (m_halfmove_clock < 100)
+		return (false);
+	if (!checkers())
+		return (true);
+	generateLegalMoves(list);
+	return (list.size() != 0);
+}
+
+/**
+ * drawState - Checks whether the game is drawn by threefold repetition or by
+ * the fifty-move rule
+ *
+ * Return: Rule the game is drawn by, NO_DRAW if it goes on
+ */
+DrawState Position::drawState(void) const
+{
+	if (isRepetition(2))
+		return (REPETITION_DRAW);
+	if (isFiftyMoveDraw())
+		return (FIFTY_MOVE_DRAW);
+	return (NO_DRAW);
+}
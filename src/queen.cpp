@@ -3,18 +3,16 @@
 
 #define PI 3.14159265358979323846
 
-Queen::Queen(int x, int y, bool isBlack, SDL_Renderer* renderer, ChessBoard* board)
-	: Piece(x, y, isBlack, renderer, board)
+Queen::Queen(int x, int y, bool isBlack, ChessBoard* board)
+	: Piece(x, y, isBlack, board)
 {
         piece_type = PieceType::QUEEN;
         if (isBlack)
         {
-                piece_texture = loadImage("assets/black_queen.png",
-                                renderer);
+                sprite = BLACK_QUEEN_SPRITE;
         } else
         {
-                piece_texture = loadImage("assets/white_queen.png",
-                                renderer);
+                sprite = WHITE_QUEEN_SPRITE;
         }
 }
 
@@ -1,18 +1,16 @@
 #include "../headers/pieces.h"
 #include "../headers/game.h"
 
-Rook::Rook(int x, int y, bool isBlack, SDL_Renderer* renderer, ChessBoard* board)
-	: Piece(x, y, isBlack, renderer, board)
+Rook::Rook(int x, int y, bool isBlack, ChessBoard* board)
+	: Piece(x, y, isBlack, board)
 {
 	piece_type = PieceType::ROOK;
 	if (isBlack)
 	{
-		piece_texture = loadImage("assets/black_rook.png",
-				renderer);
+		sprite = BLACK_ROOK_SPRITE;
 	} else
 	{
-		piece_texture = loadImage("assets/white_rook.png",
-				renderer);
+		sprite = WHITE_ROOK_SPRITE;
 	}
 	m_has_moved = false;
 }
@@ -0,0 +1,575 @@
+#include "../headers/search.h"
+#include <string.h>
+#include <thread>
+
+// Values of the captured and capturing pieces for move ordering
+static const int order_values[7] = { 10000, 900, 500, 330, 320, 100, 0 };
+
+const int TT_MOVE_ORDER = 1 << 30;
+const int CAPTURE_ORDER = 1 << 24;
+const int KILLER_ORDER = 1 << 23;
+
+/**
+ * scoreToTable - Turns a mate score relative to the root into one relative
+ * to the current node, so it stays valid wherever the position recurs
+ *
+ * @score: Score relative to the root
+ * @ply: Distance of the node from the root
+ *
+ * Return: Score to store
+ */
+static int scoreToTable(int score, int ply)
+{
+	if (score >= MATE_BOUND)
+		return (score + ply);
+	if (score <= -MATE_BOUND)
+		return (score - ply);
+	return (score);
+}
+
+/**
+ * scoreFromTable - Reverses scoreToTable
+ *
+ * @score: Stored score
+ * @ply: Distance of the node from the root
+ *
+ * Return: Score relative to the root
+ */
+static int scoreFromTable(int score, int ply)
+{
+	if (score >= MATE_BOUND)
+		return (score - ply);
+	if (score <= -MATE_BOUND)
+		return (score + ply);
+	return (score);
+}
+
+/**
+ * pickMove - Swaps the best scored move left in the list to the front of the
+ * unsearched part, so moves are sorted lazily as they are needed
+ *
+ * @list: Moves being searched
+ * @scores: Ordering score of each move
+ * @index: Index of the next move to search
+ *
+ * Return: Nothing
+ */
+static void pickMove(MoveList &list, int *scores, int index)
+{
+	CompactMove move;
+	int best, score;
+
+	best = index;
+	for (int i = index + 1; i < list.size(); i++)
+		if (scores[i] > scores[best])
+			best = i;
+	if (best == index)
+		return;
+	move = list[index];
+	list[index] = list[best];
+	list[best] = move;
+	score = scores[index];
+	scores[index] = scores[best];
+	scores[best] = score;
+}
+
+Search::Search(TranspositionTable *table)
+	: m_table(table), m_stop(false), m_nodes(0), m_first_depth(1),
+	m_report(nullptr), m_report_data(nullptr)
+{
+}
+
+/**
+ * elapsedSeconds - Time spent by the running search
+ *
+ * Return: Seconds since the search started
+ */
+double Search::elapsedSeconds(void) const
+{
+	return (std::chrono::duration<double>(std::chrono::steady_clock::now() -
+				m_start).count());
+}
+
+/**
+ * countNode - Counts one node. Only the searching thread writes m_nodes, so
+ * a plain load and store is enough and no locked instruction is needed
+ *
+ * Return: Nothing
+ */
+void Search::countNode(void)
+{
+	m_nodes.store(m_nodes.load(std::memory_order_relaxed) + 1,
+			std::memory_order_relaxed);
+}
+
+/**
+ * limitReached - Raises m_stop once the node or time budget is spent. Only
+ * polled every 1024 nodes to keep the clock off the hot path
+ *
+ * Return: true if the search must stop, false otherwise
+ */
+bool Search::limitReached(void)
+{
+	uint64_t nodes;
+
+	nodes = m_nodes.load(std::memory_order_relaxed);
+	if ((nodes & 1023) == 0)
+	{
+		if (m_limits.nodes && nodes >= m_limits.nodes)
+			m_stop = true;
+		else if (m_limits.movetime &&
+				elapsedSeconds() * 1000 >= m_limits.movetime)
+			m_stop = true;
+	}
+	return (m_stop.load(std::memory_order_relaxed));
+}
+
+/**
+ * scoreMoves - Gives each move an ordering score: the table move first, then
+ * captures and promotions by most valuable victim, least valuable attacker,
+ * then the killers, then quiet moves by history
+ *
+ * @list: Moves to score
+ * @scores: Receives one score per move
+ * @tt_move: Move stored in the transposition table, may be null
+ * @ply: Distance of the node from the root
+ *
+ * Return: Nothing
+ */
+void Search::scoreMoves(const MoveList &list, int *scores, CompactMove tt_move,
+		int ply) const
+{
+	for (int i = 0; i < list.size(); i++)
+	{
+		CompactMove move;
+
+		move = list[i];
+		if (move == tt_move)
+			scores[i] = TT_MOVE_ORDER;
+		else if (move.isCapture() || move.isPromotion())
+		{
+			int victim;
+
+			victim = move.flags() == EN_PASSANT ? PAWN :
+				m_pos.pieceType(move.to());
+			scores[i] = CAPTURE_ORDER + order_values[victim] * 16 -
+				order_values[m_pos.pieceType(move.from())] / 16 +
+				order_values[move.promotion()];
+		} else if (move == m_killers[ply][0] || move == m_killers[ply][1])
+			scores[i] = KILLER_ORDER;
+		else
+			scores[i] = m_history[m_pos.blackTurn()][move.from()][move.to()];
+	}
+}
+
+/**
+ * quiescence - Searches captures and promotions only until the position is
+ * quiet, so the horizon never falls in the middle of an exchange. A side in
+ * check searches every evasion instead
+ *
+ * @alpha: Lower bound of the window
+ * @beta: Upper bound of the window
+ * @ply: Distance of the node from the root
+ *
+ * Return: Score relative to the side to move
+ */
+int Search::quiescence(int alpha, int beta, int ply)
+{
+	MoveList list;
+	int scores[MAX_MOVES];
+	int best, score;
+	bool in_check;
+
+	countNode();
+	if (limitReached())
+		return (0);
+	if (ply >= MAX_PLY - 1)
+		return (evaluate(m_pos));
+
+	in_check = m_pos.checkers() != 0;
+	best = -INFINITE_SCORE;
+	if (!in_check)
+	{
+		best = evaluate(m_pos);
+		if (best >= beta)
+			return (best);
+		if (best > alpha)
+			alpha = best;
+	}
+
+	m_pos.generateLegalMoves(list);
+	if (in_check && list.size() == 0)
+		return (-MATE_SCORE + ply);
+	scoreMoves(list, scores, CompactMove(), ply);
+	for (int i = 0; i < list.size(); i++)
+	{
+		pickMove(list, scores, i);
+		if (!in_check && !list[i].isCapture() && !list[i].isPromotion())
+			break;
+		m_pos.makeMove(list[i]);
+		score = -quiescence(-beta, -alpha, ply + 1);
+		m_pos.unmakeMove();
+		if (m_stop.load(std::memory_order_relaxed))
+			return (0);
+		if (score > best)
+		{
+			best = score;
+			if (score > alpha)
+				alpha = score;
+			if (score >= beta)
+				break;
+		}
+	}
+	return (best);
+}
+
+/**
+ * negamax - Principal variation alpha-beta search. The first move gets the
+ * full window, the rest a null window re-searched only when they beat alpha
+ *
+ * @depth: Remaining depth, quiescence takes over at 0
+ * @alpha: Lower bound of the window
+ * @beta: Upper bound of the window
+ * @ply: Distance of the node from the root
+ *
+ * Return: Score relative to the side to move, 0 if the search was stopped
+ */
+int Search::negamax(int depth, int alpha, int beta, int ply)
+{
+	MoveList list;
+	CompactMove tt_move, best_move;
+	TTHit hit;
+	int scores[MAX_MOVES];
+	int best, score, original_alpha;
+	bool in_check, pv_node;
+
+	m_pv_length[ply] = ply;
+	// A position met again is scored as the draw it would be if repeated
+	// once more, so the search never goes round in circles
+	if (ply && (m_pos.isRepetition(1) || m_pos.isFiftyMoveDraw()))
+		return (0);
+	in_check = m_pos.checkers() != 0;
+	if (in_check)
+		depth++;
+	if (depth <= 0)
+		return (quiescence(alpha, beta, ply));
+	countNode();
+	if (limitReached())
+		return (0);
+	if (ply >= MAX_PLY - 1)
+		return (evaluate(m_pos));
+
+	// A deep enough stored result settles the node outside the PV
+	pv_node = beta - alpha > 1;
+	tt_move = CompactMove();
+	if (m_table->probe(m_pos.key(), &hit))
+	{
+		tt_move = hit.move;
+		score = scoreFromTable(hit.score, ply);
+		if (!pv_node && ply && hit.depth >= depth &&
+				(hit.bound == BOUND_EXACT ||
+				 (hit.bound == BOUND_LOWER && score >= beta) ||
+				 (hit.bound == BOUND_UPPER && score <= alpha)))
+			return (score);
+	}
+
+	m_pos.generateLegalMoves(list);
+	if (list.size() == 0)
+		return (in_check ? -MATE_SCORE + ply : 0);
+	scoreMoves(list, scores, tt_move, ply);
+
+	original_alpha = alpha;
+	best = -INFINITE_SCORE;
+	best_move = CompactMove();
+	for (int i = 0; i < list.size(); i++)
+	{
+		CompactMove move;
+
+		pickMove(list, scores, i);
+		move = list[i];
+		m_pos.makeMove(move);
+		if (i == 0)
+			score = -negamax(depth - 1, -beta, -alpha, ply + 1);
+		else
+		{
+			score = -negamax(depth - 1, -alpha - 1, -alpha, ply + 1);
+			if (score > alpha && score < beta)
+				score = -negamax(depth - 1, -beta, -alpha, ply + 1);
+		}
+		m_pos.unmakeMove();
+		if (m_stop.load(std::memory_order_relaxed))
+			return (0);
+
+		if (score <= best)
+			continue;
+		best = score;
+		best_move = move;
+		if (score <= alpha)
+			continue;
+		alpha = score;
+		m_pv[ply][ply] = move;
+		for (int j = ply + 1; j < m_pv_length[ply + 1]; j++)
+			m_pv[ply][j] = m_pv[ply + 1][j];
+		m_pv_length[ply] = m_pv_length[ply + 1] > ply + 1 ?
+			m_pv_length[ply + 1] : ply + 1;
+		if (score < beta)
+			continue;
+
+		// Beta cutoff, remember the quiet move that caused it
+		if (!move.isCapture() && !move.isPromotion())
+		{
+			if (m_killers[ply][0] != move)
+			{
+				m_killers[ply][1] = m_killers[ply][0];
+				m_killers[ply][0] = move;
+			}
+			m_history[m_pos.blackTurn()][move.from()][move.to()] +=
+				depth * depth;
+		}
+		break;
+	}
+
+	m_table->store(m_pos.key(), best_move, scoreToTable(best, ply), depth,
+			best >= beta ? BOUND_LOWER :
+			best > original_alpha ? BOUND_EXACT : BOUND_UPPER);
+	return (best);
+}
+
+/**
+ * run - Searches a position with iterative deepening until a limit is hit,
+ * reporting each completed iteration
+ *
+ * @root: Position to search, left untouched
+ * @limits: When to stop
+ *
+ * Return: Result of the deepest completed iteration
+ */
+SearchResult Search::run(const Position &root, const SearchLimits &limits)
+{
+	m_stop = false;
+	m_table->newSearch();
+	return (iterate(root, limits));
+}
+
+/**
+ * iterate - Body of run, leaving m_stop and the table generation to the
+ * caller so LazySmp can set them once for every thread
+ *
+ * @root: Position to search, left untouched
+ * @limits: When to stop
+ *
+ * Return: Result of the deepest completed iteration
+ */
+SearchResult Search::iterate(const Position &root, const SearchLimits &limits)
+{
+	SearchResult result;
+	MoveList list;
+	int max_depth;
+
+	// Repetitions reach back into the game, so only the history no
+	// repetition can reach is dropped
+	m_pos = root;
+	m_pos.trimHistory(m_pos.halfmoveClock());
+	m_limits = limits;
+	m_start = std::chrono::steady_clock::now();
+	m_nodes = 0;
+	memset(m_killers, 0, sizeof(m_killers));
+	memset(m_history, 0, sizeof(m_history));
+
+	result = SearchResult();
+	m_pos.generateLegalMoves(list);
+	if (list.size() == 0)
+	{
+		result.score = m_pos.checkers() ? -MATE_SCORE : 0;
+		return (result);
+	}
+	result.best_move = list[0];
+
+	max_depth = limits.depth > 0 && limits.depth < MAX_PLY - 1 ?
+		limits.depth : MAX_PLY - 1;
+	for (int depth = m_first_depth; depth <= max_depth; depth++)
+	{
+		int score;
+
+		// A stopped iteration is thrown away, except at depth 1 which has to
+		// give the main search a move. A helper starting deeper leaves its
+		// depth at 0 then, so LazySmp never takes its partial result
+		score = negamax(depth, -INFINITE_SCORE, INFINITE_SCORE, 0);
+		if (m_stop.load() && depth > 1)
+			break;
+
+		result.score = score;
+		result.depth = depth;
+		result.pv_length = m_pv_length[0];
+		for (int i = 0; i < result.pv_length; i++)
+			result.pv[i] = m_pv[0][i];
+		if (result.pv_length)
+			result.best_move = result.pv[0];
+		result.nodes = nodes();
+		result.seconds = elapsedSeconds();
+		result.nps = result.seconds > 0 ?
+			(uint64_t) (result.nodes / result.seconds) : 0;
+		if (m_report)
+			m_report(&result, m_report_data);
+
+		// Stop early on a forced mate, or when the next iteration is
+		// unlikely to finish within the budget
+		if (m_stop.load() || score >= MATE_BOUND || score <= -MATE_BOUND ||
+				(limits.movetime &&
+				 result.seconds * 1000 * 2 >= limits.movetime))
+			break;
+	}
+	result.nodes = nodes();
+	result.seconds = elapsedSeconds();
+	result.nps = result.seconds > 0 ?
+		(uint64_t) (result.nodes / result.seconds) : 0;
+	return (result);
+}
+
+/**
+ * LazySmp - Creates the searchers
+ *
+ * @table: Transposition table shared by every thread
+ * @threads: Number of threads, at least 1
+ *
+ * Return: Nothing
+ */
+LazySmp::LazySmp(TranspositionTable *table, int threads)
+	: m_table(table), m_report(nullptr), m_report_data(nullptr)
+{
+	setThreads(threads);
+}
+
+LazySmp::~LazySmp(void)
+{
+	setThreads(0);
+}
+
+/**
+ * setThreads - Changes the number of threads. Must not be called while a
+ * search is running
+ *
+ * @threads: Number of threads, at least 1 outside the destructor
+ *
+ * Return: Nothing
+ */
+void LazySmp::setThreads(int threads)
+{
+	while ((int) m_searches.size() > threads)
+	{
+		delete m_searches.back();
+		m_searches.pop_back();
+	}
+	while ((int) m_searches.size() < threads)
+	{
+		Search *search;
+
+		search = new Search(m_table);
+		search->setFirstDepth(1 + m_searches.size() % 2);
+		m_searches.push_back(search);
+	}
+	if (!m_searches.empty())
+		m_searches[0]->setFirstDepth(1);
+}
+
+/**
+ * stop - Aborts the running search on every thread
+ *
+ * Return: Nothing
+ */
+void LazySmp::stop(void)
+{
+	for (size_t i = 0; i < m_searches.size(); i++)
+		m_searches[i]->stop();
+}
+
+/**
+ * nodes - Counts the nodes visited by every thread
+ *
+ * Return: Total number of nodes of the running or last search
+ */
+uint64_t LazySmp::nodes(void) const
+{
+	uint64_t total;
+
+	total = 0;
+	for (size_t i = 0; i < m_searches.size(); i++)
+		total += m_searches[i]->nodes();
+	return (total);
+}
+
+/**
+ * mainReport - Reports an iteration of the main search with the node count
+ * and speed of all the threads together
+ *
+ * @result: Result of the main search iteration
+ * @data: The LazySmp running the search
+ *
+ * Return: Nothing
+ */
+void LazySmp::mainReport(const SearchResult *result, void *data)
+{
+	LazySmp *smp;
+	SearchResult combined;
+
+	smp = (LazySmp *) data;
+	if (!smp->m_report)
+		return;
+	combined = *result;
+	combined.nodes = smp->nodes();
+	combined.nps = combined.seconds > 0 ?
+		(uint64_t) (combined.nodes / combined.seconds) : 0;
+	smp->m_report(&combined, smp->m_report_data);
+}
+
+/**
+ * run - Searches a position on every thread until the main search hits a
+ * limit. A helper that completed a deeper iteration than the main search
+ * supplies the move
+ *
+ * @root: Position to search, left untouched
+ * @limits: When to stop, the node limit counts the main thread only
+ *
+ * Return: Best result found, with the nodes of every thread
+ */
+SearchResult LazySmp::run(const Position &root, const SearchLimits &limits)
+{
+	std::vector<std::thread> helpers;
+	std::vector<SearchResult> results;
+	SearchLimits helper_limits;
+	SearchResult result;
+	double seconds;
+
+	// Every flag is lowered before any thread starts, so a stop raised
+	// early by the main search can never be missed by a late helper
+	for (size_t i = 0; i < m_searches.size(); i++)
+		m_searches[i]->m_stop = false;
+	m_table->newSearch();
+
+	helper_limits.depth = limits.depth;
+	helper_limits.nodes = 0;
+	helper_limits.movetime = 0;
+	results.resize(m_searches.size());
+	for (size_t i = 1; i < m_searches.size(); i++)
+		helpers.push_back(std::thread([this, &root, &helper_limits,
+					&results, i]() {
+			results[i] = m_searches[i]->iterate(root, helper_limits);
+		}));
+
+	m_searches[0]->setReport(mainReport, this);
+	result = m_searches[0]->iterate(root, limits);
+	seconds = result.seconds;
+	for (size_t i = 1; i < m_searches.size(); i++)
+		m_searches[i]->stop();
+	for (size_t i = 0; i < helpers.size(); i++)
+		helpers[i].join();
+
+	for (size_t i = 1; i < results.size(); i++)
+		if (results[i].depth > result.depth && !results[i].best_move.isNull())
+			result = results[i];
+	result.nodes = nodes();
+	result.seconds = seconds;
+	result.nps = result.seconds > 0 ?
+		(uint64_t) (result.nodes / result.seconds) : 0;
+	return (result);
+}
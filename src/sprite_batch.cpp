@@ -0,0 +1,82 @@
+#include "../headers/sprite_batch.h"
+
+/**
+ * SpriteBatch - Creates an empty batch
+ *
+ * @renderer: Renderer to submit the batch to
+ * @atlas: Atlas every sprite comes from
+ *
+ * Return: Nothing
+ */
+SpriteBatch::SpriteBatch(SDL_Renderer* renderer, const TextureAtlas* atlas)
+{
+	m_renderer = renderer;
+	m_atlas = atlas;
+	m_count = 0;
+
+	// Every quad is split along the same diagonal, the indices never change
+	for (int i = 0; i < MAX_BATCH_SPRITES; i++)
+	{
+		m_indices[i * 6] = i * 4;
+		m_indices[i * 6 + 1] = i * 4 + 1;
+		m_indices[i * 6 + 2] = i * 4 + 2;
+		m_indices[i * 6 + 3] = i * 4 + 2;
+		m_indices[i * 6 + 4] = i * 4 + 3;
+		m_indices[i * 6 + 5] = i * 4;
+	}
+}
+
+/**
+ * add - Queues a sprite, flushing first if the batch is full
+ *
+ * @sprite: Sprite of the atlas to draw
+ * @dest: Area to stretch the sprite over
+ *
+ * Return: Nothing
+ */
+void SpriteBatch::add(int sprite, const SDL_Rect* dest)
+{
+	const SDL_Rect* src;
+	SDL_Vertex* v;
+	float u0, v0, u1, v1;
+
+	src = m_atlas->getRect(sprite);
+	if (src->w == 0 || m_atlas->getWidth() == 0)
+		return;
+	if (m_count == MAX_BATCH_SPRITES)
+		flush();
+
+	u0 = (float) src->x / m_atlas->getWidth();
+	v0 = (float) src->y / m_atlas->getHeight();
+	u1 = (float) (src->x + src->w) / m_atlas->getWidth();
+	v1 = (float) (src->y + src->h) / m_atlas->getHeight();
+
+	// Corners clockwise from the top left
+	v = &m_vertices[m_count * 4];
+	v[0] = { { (float) dest->x, (float) dest->y },
+		{ 255, 255, 255, 255 }, { u0, v0 } };
+	v[1] = { { (float) (dest->x + dest->w), (float) dest->y },
+		{ 255, 255, 255, 255 }, { u1, v0 } };
+	v[2] = { { (float) (dest->x + dest->w), (float) (dest->y + dest->h) },
+		{ 255, 255, 255, 255 }, { u1, v1 } };
+	v[3] = { { (float) dest->x, (float) (dest->y + dest->h) },
+		{ 255, 255, 255, 255 }, { u0, v1 } };
+	m_count++;
+}
+
+/**
+ * flush - Draws every queued sprite onto the current render target in one
+ * call and empties the batch
+ *
+ * Return: Nothing
+ */
+void SpriteBatch::flush(void)
+{
+	if (m_count == 0)
+		return;
+	if (SDL_RenderGeometry(m_renderer, m_atlas->getTexture(), m_vertices,
+				m_count * 4, m_indices, m_count * 6) != 0)
+		SDL_Log("Failed to render sprite batch!!!\nError Output: %s\n",
+				SDL_GetError());
+	m_count = 0;
+}
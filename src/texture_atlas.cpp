@@ -0,0 +1,159 @@
+#include "../headers/view.h"
+#include "../headers/metrics.h"
+#include <SDL2/SDL_image.h>
+
+// Image of each Sprite, in enum order
+static const char *const sprite_paths[SPRITE_COUNT] = {
+	"assets/white_king.png", "assets/white_queen.png",
+	"assets/white_rook.png", "assets/white_bishop.png",
+	"assets/white_knight.png", "assets/white_pawn.png",
+	"assets/black_king.png", "assets/black_queen.png",
+	"assets/black_rook.png", "assets/black_bishop.png",
+	"assets/black_knight.png", "assets/black_pawn.png",
+	"assets/white_knight2.png", "assets/black_knight2.png",
+	"assets/active_black_piece.png", "assets/active_white_piece.png",
+	"assets/possible_squares.png", "assets/possible_capture.png",
+	"assets/castling_square.png"
+};
+
+const int ATLAS_COLUMNS = 8;
+
+/**
+ * TextureAtlas - Decodes every sprite image and packs them at their own size
+ *
+ * @renderer: Renderer the texture is created for
+ *
+ * Return: Nothing
+ */
+TextureAtlas::TextureAtlas(SDL_Renderer* renderer)
+{
+	m_renderer = renderer;
+	m_texture = nullptr;
+	m_width = 0;
+	m_height = 0;
+	m_sprite_size = 0;
+	for (int i = 0; i < SPRITE_COUNT; i++)
+	{
+		SDL_Surface* image;
+
+		m_images[i] = nullptr;
+		m_rects[i] = { 0, 0, 0, 0 };
+		image = IMG_Load(sprite_paths[i]);
+		if (image == nullptr)
+		{
+			SDL_Log("Unable to load image from %s\nError Output: %s\n",
+					sprite_paths[i], IMG_GetError());
+			continue;
+		}
+		m_images[i] = SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_RGBA32, 0);
+		SDL_FreeSurface(image);
+	}
+	build(0);
+}
+
+TextureAtlas::~TextureAtlas(void)
+{
+	if (m_texture)
+		SDL_DestroyTexture(m_texture);
+	for (int i = 0; i < SPRITE_COUNT; i++)
+		if (m_images[i])
+			SDL_FreeSurface(m_images[i]);
+}
+
+/**
+ * build - Packs the images into the texture, one cell per sprite in a grid of
+ * ATLAS_COLUMNS columns, doing nothing if it is already packed at that size
+ *
+ * @sprite_size: Side every sprite is scaled to, 0 to keep their own sizes
+ *
+ * Return: true on success, Otherwise false
+ */
+bool TextureAtlas::build(int sprite_size)
+{
+	SDL_Surface* sheet;
+	int cell_w, cell_h, rows;
+
+	if (m_texture && sprite_size == m_sprite_size)
+		return (true);
+	if (m_texture)
+		SDL_DestroyTexture(m_texture);
+	m_texture = nullptr;
+	m_width = 0;
+	m_height = 0;
+	m_sprite_size = sprite_size;
+
+	cell_w = sprite_size;
+	cell_h = sprite_size;
+	for (int i = 0; i < SPRITE_COUNT && sprite_size == 0; i++)
+	{
+		if (m_images[i] == nullptr)
+			continue;
+		cell_w = m_images[i]->w > cell_w ? m_images[i]->w : cell_w;
+		cell_h = m_images[i]->h > cell_h ? m_images[i]->h : cell_h;
+	}
+
+	rows = (SPRITE_COUNT + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS;
+	sheet = SDL_CreateRGBSurfaceWithFormat(0, cell_w * ATLAS_COLUMNS,
+			cell_h * rows, 32, SDL_PIXELFORMAT_RGBA32);
+	if (sheet == nullptr)
+	{
+		SDL_Log("Unable to create the atlas surface\nError Output: %s\n",
+				SDL_GetError());
+		return (false);
+	}
+
+	// Copy the pixels as they are, alpha included, rather than blending
+	for (int i = 0; i < SPRITE_COUNT; i++)
+	{
+		SDL_Rect cell;
+
+		m_rects[i] = { 0, 0, 0, 0 };
+		if (m_images[i] == nullptr)
+			continue;
+		m_rects[i] = { (i % ATLAS_COLUMNS) * cell_w,
+			(i / ATLAS_COLUMNS) * cell_h,
+			sprite_size ? sprite_size : m_images[i]->w,
+			sprite_size ? sprite_size : m_images[i]->h };
+
+		// SDL_BlitSurface clips its destination rectangle in place
+		cell = m_rects[i];
+		if (sprite_size)
+			SDL_SoftStretchLinear(m_images[i], nullptr, sheet, &cell);
+		else
+		{
+			SDL_SetSurfaceBlendMode(m_images[i], SDL_BLENDMODE_NONE);
+			SDL_BlitSurface(m_images[i], nullptr, sheet, &cell);
+		}
+	}
+
+	m_texture = SDL_CreateTextureFromSurface(m_renderer, sheet);
+	if (m_texture == nullptr)
+		SDL_Log("Unable to create the atlas texture\nError Output: %s\n",
+				SDL_GetError());
+	else
+	{
+		metrics.textures++;
+		SDL_SetTextureBlendMode(m_texture, SDL_BLENDMODE_BLEND);
+		m_width = sheet->w;
+		m_height = sheet->h;
+	}
+	SDL_FreeSurface(sheet);
+	return (m_texture != nullptr);
+}
+
+/**
+ * draw - Copies a sprite onto the current render target
+ *
+ * @renderer: Renderer to draw with
+ * @sprite: Sprite to draw
+ * @dest: Area to stretch the sprite over
+ *
+ * Return: Nothing
+ */
+void TextureAtlas::draw(SDL_Renderer* renderer, int sprite,
+		const SDL_Rect* dest) const
+{
+	if (m_texture == nullptr || m_rects[sprite].w == 0)
+		return;
+	SDL_RenderCopy(renderer, m_texture, &m_rects[sprite], dest);
+}
@@ -0,0 +1,231 @@
+#include "../headers/transposition.h"
+
+/**
+ * packEntry - Packs the fields of an entry into its data word
+ *
+ * @move: Best move
+ * @score: Score, must fit in 16 bits
+ * @depth: Search depth, must fit in 8 bits
+ * @bound: Bound type of score
+ * @generation: Age of the search storing the entry
+ *
+ * Return: The packed data word
+ */
+static uint64_t packEntry(CompactMove move, int score, int depth, Bound bound,
+		int generation)
+{
+	return ((uint64_t) move.raw() |
+			((uint64_t) (uint16_t) (int16_t) score << 16) |
+			((uint64_t) (uint8_t) (int8_t) depth << 32) |
+			((uint64_t) bound << 40) |
+			((uint64_t) generation << 42));
+}
+
+/**
+ * entryDepth - Reads the depth back out of a data word
+ *
+ * @data: Packed data word
+ *
+ * Return: Stored depth
+ */
+static int entryDepth(uint64_t data)
+{
+	return ((int8_t) (uint8_t) (data >> 32));
+}
+
+/**
+ * entryGeneration - Reads the search generation back out of a data word
+ *
+ * @data: Packed data word
+ *
+ * Return: Stored generation
+ */
+static int entryGeneration(uint64_t data)
+{
+	return ((int) (data >> 42) & 63);
+}
+
+/**
+ * TranspositionTable - Allocates a cleared table
+ *
+ * @megabytes: Memory to use, rounded down to a power of two buckets
+ * @policy: How full buckets are replaced into
+ *
+ * Return: Nothing
+ */
+TranspositionTable::TranspositionTable(size_t megabytes, ReplacePolicy policy)
+	: m_buckets(nullptr), m_mask(0), m_megabytes(0), m_generation(0),
+	m_policy(policy)
+{
+	resize(megabytes);
+}
+
+TranspositionTable::~TranspositionTable(void)
+{
+	delete[] m_buckets;
+}
+
+/**
+ * resize - Reallocates the table to a new size and clears it. Must not be
+ * called while a search is using the table
+ *
+ * @megabytes: Memory to use, rounded down to a power of two buckets
+ *
+ * Return: Nothing
+ */
+void TranspositionTable::resize(size_t megabytes)
+{
+	size_t buckets;
+
+	buckets = 1;
+	while (buckets * 2 * sizeof(TTBucket) <= megabytes * 1024 * 1024)
+		buckets *= 2;
+	delete[] m_buckets;
+	m_buckets = new TTBucket[buckets];
+	m_mask = buckets - 1;
+	m_megabytes = megabytes;
+	clear();
+}
+
+/**
+ * clear - Empties every entry and resets the search generation. Must not be
+ * called while a search is using the table
+ *
+ * Return: Nothing
+ */
+void TranspositionTable::clear(void)
+{
+	for (size_t i = 0; i <= m_mask; i++)
+	{
+		for (int j = 0; j < TT_BUCKET_SIZE; j++)
+		{
+			m_buckets[i].entries[j].check.store(0, std::memory_order_relaxed);
+			m_buckets[i].entries[j].data.store(0, std::memory_order_relaxed);
+		}
+	}
+	m_generation = 0;
+}
+
+/**
+ * probe - Looks up the stored result of a position
+ *
+ * @key: Zobrist key of the position
+ * @hit: Set to the decoded entry on a hit
+ *
+ * Return: true on a hit, false otherwise
+ */
+bool TranspositionTable::probe(uint64_t key, TTHit *hit) const
+{
+	const TTBucket *bucket;
+
+	bucket = &m_buckets[key & m_mask];
+	for (int i = 0; i < TT_BUCKET_SIZE; i++)
+	{
+		uint64_t check, data;
+		uint16_t raw;
+
+		check = bucket->entries[i].check.load(std::memory_order_relaxed);
+		data = bucket->entries[i].data.load(std::memory_order_relaxed);
+		if ((check ^ data) != key || ((data >> 40) & 3) == BOUND_NONE)
+			continue;
+		raw = (uint16_t) data;
+		hit->move = CompactMove(raw & 63, (raw >> 6) & 63, raw >> 12);
+		hit->score = (int16_t) (uint16_t) (data >> 16);
+		hit->depth = entryDepth(data);
+		hit->bound = (Bound) ((data >> 40) & 3);
+		return (true);
+	}
+	return (false);
+}
+
+/**
+ * store - Records the result of a search. An entry already holding the
+ * position is updated in place, keeping its move when none is given, else
+ * the policy picks the entry to overwrite
+ *
+ * @key: Zobrist key of the position
+ * @move: Best move found, may be null
+ * @score: Score relative to the side to move
+ * @depth: Depth searched to
+ * @bound: How score relates to the true score
+ *
+ * Return: Nothing
+ */
+void TranspositionTable::store(uint64_t key, CompactMove move, int score,
+		int depth, Bound bound)
+{
+	TTBucket *bucket;
+	TTEntry *victim;
+	uint64_t packed;
+	int victim_value;
+
+	bucket = &m_buckets[key & m_mask];
+	victim = nullptr;
+	victim_value = 0;
+	for (int i = 0; i < TT_BUCKET_SIZE; i++)
+	{
+		TTEntry *entry;
+		uint64_t check, data;
+		int age, value;
+
+		entry = &bucket->entries[i];
+		check = entry->check.load(std::memory_order_relaxed);
+		data = entry->data.load(std::memory_order_relaxed);
+		if ((check ^ data) == key)
+		{
+			// Same position, keep a deeper result of the current search
+			if (m_policy == DEPTH_PREFERRED && bound != BOUND_EXACT &&
+					entryGeneration(data) == m_generation &&
+					entryDepth(data) > depth)
+				return;
+			if (move.isNull())
+				move = CompactMove((uint16_t) data & 63,
+						((uint16_t) data >> 6) & 63, (uint16_t) data >> 12);
+			victim = entry;
+			break;
+		}
+
+		// Empty entries go first, then the shallowest counting 8 plies of
+		// depth for every search of age, or just the oldest
+		age = (m_generation - entryGeneration(data)) & 63;
+		value = m_policy == ALWAYS_REPLACE ? -age : entryDepth(data) - 8 * age;
+		if (!data)
+			value = -1000;
+		if (!victim || value < victim_value)
+		{
+			victim = entry;
+			victim_value = value;
+		}
+	}
+
+	packed = packEntry(move, score, depth, bound, m_generation);
+	victim->check.store(key ^ packed, std::memory_order_relaxed);
+	victim->data.store(packed, std::memory_order_relaxed);
+}
+
+/**
+ * hashfull - Estimates how full the table is from its first buckets
+ *
+ * Return: Permille of sampled entries written by the current search
+ */
+int TranspositionTable::hashfull(void) const
+{
+	size_t sample;
+	int used;
+
+	sample = m_mask + 1 < 250 ? m_mask + 1 : 250;
+	used = 0;
+	for (size_t i = 0; i < sample; i++)
+	{
+		for (int j = 0; j < TT_BUCKET_SIZE; j++)
+		{
+			uint64_t data;
+
+			data = m_buckets[i].entries[j].data.load(
+					std::memory_order_relaxed);
+			if (data && entryGeneration(data) == m_generation)
+				used++;
+		}
+	}
+	return ((int) (used * 1000 / (sample * TT_BUCKET_SIZE)));
+}
@@ -1,4 +1,5 @@
 #include "../headers/view.h"
+#include "../headers/metrics.h"
 #include <SDL2/SDL_image.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -26,6 +27,30 @@ bool init(void)
 	return (true);
 }
 
+/**
+ * initHeadless - Performs initialization operations for SDL_image only, the
+ * video subsystem needs a display and the software renderer does not
+ *
+ * Return: true if initialization was a success, Otherwise false
+ */
+bool initHeadless(void)
+{
+	if (SDL_Init(0) < 0)
+	{
+		SDL_Log("Failed to initialize SDL!!!\nSDL Error Output: %s\n",
+				SDL_GetError());
+		return (false);
+	}
+
+	if (!IMG_Init(IMG_INIT_PNG))
+	{
+		SDL_Log("Failed to initialize SDL_image!!!\nSDL_image Error Output: %s\n",
+				IMG_GetError());
+		return (false);
+	}
+	return (true);
+}
+
 /**
  * createWindow - Creates and returns window based on the arguments passed
  *
@@ -82,7 +107,8 @@ SDL_Texture* loadImage(const char* path, SDL_Renderer* renderer)
 		{
 			SDL_Log("Unable to create texture from %s\nError Output: %s",
 					path, SDL_GetError());
-		}
+		} else
+			metrics.textures++;
 		SDL_FreeSurface(image);
 	}
 
@@ -116,6 +142,42 @@ SDL_Renderer* createRenderer(SDL_Window* window, unsigned int flags)
 	return (renderer);
 }
 
+/**
+ * createOffscreenRenderer - Creates a software renderer drawing into a new
+ * surface instead of a window
+ *
+ * @surface: Set to the surface the renderer draws into, which the caller
+ * frees after destroying the renderer
+ * @width: Width of the surface
+ * @height: Height of the surface
+ *
+ * Return: Pointer to the created SDL_Renderer, nullptr on failure
+ */
+SDL_Renderer* createOffscreenRenderer(SDL_Surface** surface, int width,
+		int height)
+{
+	SDL_Renderer* renderer;
+
+	renderer = nullptr;
+	*surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32,
+			SDL_PIXELFORMAT_ARGB8888);
+	if (*surface == nullptr)
+	{
+		SDL_Log("Failed to create surface!!!\nError Output: %s\n",
+				SDL_GetError());
+		return (renderer);
+	}
+	renderer = SDL_CreateSoftwareRenderer(*surface);
+	if (renderer == nullptr)
+	{
+		SDL_Log("Failed to create renderer!!!\nError Output: %s\n",
+				SDL_GetError());
+		SDL_FreeSurface(*surface);
+		*surface = nullptr;
+	}
+	return (renderer);
+}
+
 /**
  * wrapUp - Closes SDL and SDL_image
  *
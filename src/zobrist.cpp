@@ -0,0 +1,56 @@
+#include "../headers/zobrist.h"
+
+uint64_t zobrist_pieces[2][6][64];
+uint64_t zobrist_castling[16];
+uint64_t zobrist_ep[8];
+uint64_t zobrist_black;
+
+/**
+ * nextRandom - Steps a xorshift64* generator
+ *
+ * @state: Generator state, must not be zero
+ *
+ * Return: The next pseudo random number
+ */
+static uint64_t nextRandom(uint64_t *state)
+{
+	*state ^= *state >> 12;
+	*state ^= *state << 25;
+	*state ^= *state >> 27;
+	return (*state * 2685821657736338717ULL);
+}
+
+/**
+ * buildKeys - Fills every key table, see initZobrist
+ *
+ * Return: Always true
+ */
+static bool buildKeys(void)
+{
+	uint64_t state;
+
+	state = 1070372ULL;
+	for (int c = 0; c < 2; c++)
+		for (int t = 0; t < 6; t++)
+			for (int sq = 0; sq < 64; sq++)
+				zobrist_pieces[c][t][sq] = nextRandom(&state);
+	for (int i = 0; i < 16; i++)
+		zobrist_castling[i] = nextRandom(&state);
+	for (int i = 0; i < 8; i++)
+		zobrist_ep[i] = nextRandom(&state);
+	zobrist_black = nextRandom(&state);
+	return (true);
+}
+
+/**
+ * initZobrist - Draws the Zobrist keys. Safe to call any number of times and
+ * from any thread, the keys are only drawn once
+ *
+ * Return: Nothing
+ */
+void initZobrist(void)
+{
+	static const bool built = buildKeys();
+
+	(void) built;
+}
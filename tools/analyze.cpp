@@ -0,0 +1,225 @@
+#include "../headers/search.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * printScore - Prints a score as centipawns or as moves to mate
+ *
+ * @score: Score relative to the side to move
+ *
+ * Return: Nothing
+ */
+static void printScore(int score)
+{
+	if (score >= MATE_BOUND)
+		printf("mate %d", (MATE_SCORE - score + 1) / 2);
+	else if (score <= -MATE_BOUND)
+		printf("mate -%d", (MATE_SCORE + score + 1) / 2);
+	else
+		printf("cp %d", score);
+}
+
+/**
+ * report - Prints one line per completed iteration
+ *
+ * @result: Result of the iteration
+ * @data: Unused
+ *
+ * Return: Nothing
+ */
+static void report(const SearchResult *result, void *data)
+{
+	(void) data;
+	printf("depth %2d score ", result->depth);
+	printScore(result->score);
+	printf(" nodes %llu nps %llu time %.3f pv",
+			(unsigned long long) result->nodes,
+			(unsigned long long) result->nps, result->seconds);
+	for (int i = 0; i < result->pv_length; i++)
+	{
+		char name[6];
+
+		moveName(result->pv[i], name);
+		printf(" %s", name);
+	}
+	printf("\n");
+	fflush(stdout);
+}
+
+// Positions searched by the time-to-depth benchmark
+static const char *const bench_fens[] = {
+	START_FEN,
+	"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+	"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+	"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+	"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8"
+};
+
+static const int bench_count = sizeof(bench_fens) / sizeof(bench_fens[0]);
+
+/**
+ * bench - Measures the time Lazy SMP takes to reach a fixed depth on the
+ * bench positions at 1, 2, 4, ... threads, the table cleared before each
+ * thread count, and prints the speedup over a single thread
+ *
+ * @depth: Depth every search runs to
+ * @max_threads: Largest thread count to measure
+ * @table: Transposition table shared by the threads
+ *
+ * Return: Always 0
+ */
+static int bench(int depth, int max_threads, TranspositionTable *table)
+{
+	LazySmp smp(table, 1);
+	SearchLimits limits;
+	double base_seconds;
+
+	limits.depth = depth;
+	limits.nodes = 0;
+	limits.movetime = 0;
+	base_seconds = 0;
+	printf("%7s %10s %14s %12s %8s\n", "threads", "time", "nodes", "nps",
+			"speedup");
+	for (int threads = 1; threads <= max_threads; threads *= 2)
+	{
+		uint64_t nodes;
+		double seconds;
+
+		smp.setThreads(threads);
+		table->clear();
+		nodes = 0;
+		seconds = 0;
+		for (int i = 0; i < bench_count; i++)
+		{
+			SearchResult result;
+			Position pos;
+
+			pos.setFen(bench_fens[i]);
+			result = smp.run(pos, limits);
+			nodes += result.nodes;
+			seconds += result.seconds;
+		}
+		if (threads == 1)
+			base_seconds = seconds;
+		printf("%7d %9.3fs %14llu %12.0f %7.2fx\n", threads, seconds,
+				(unsigned long long) nodes, seconds > 0 ? nodes / seconds : 0,
+				seconds > 0 ? base_seconds / seconds : 0);
+		fflush(stdout);
+	}
+	return (0);
+}
+
+/**
+ * usage - Prints how to run the tool
+ *
+ * @name: Name the tool was invoked as
+ *
+ * Return: Always 2
+ */
+static int usage(const char *name)
+{
+	fprintf(stderr, "usage: %s [options] [FEN]\n"
+			"       %s bench [-d depth] [-t max threads] [-H MB]\n\n"
+			"options:\n"
+			"  -d <depth>    stop after this depth\n"
+			"  -n <nodes>    stop after this many nodes\n"
+			"  -m <ms>       stop after this many milliseconds\n"
+			"  -t <threads>  Lazy SMP threads, 1 by default\n"
+			"  -H <MB>       transposition table size, 16 by default\n"
+			"\nWithout a limit the search runs for 5 seconds. bench measures\n"
+			"the time to depth at 1, 2, 4, ... up to 16 threads\n",
+			name, name);
+	return (2);
+}
+
+int main(int argc, char *argv[])
+{
+	TranspositionTable *table;
+	SearchLimits limits;
+	SearchResult result;
+	LazySmp *search;
+	Position pos;
+	char fen[256], name[6];
+	int hash_mb, threads;
+	bool run_bench;
+
+	limits.depth = 0;
+	limits.nodes = 0;
+	limits.movetime = 0;
+	hash_mb = 16;
+	threads = 0;
+	run_bench = false;
+	fen[0] = '\0';
+	for (int i = 1; i < argc; i++)
+	{
+		size_t len;
+
+		if (argv[i][0] == '-' && argv[i][1] && !argv[i][2] && i + 1 < argc)
+		{
+			switch (argv[i][1])
+			{
+				case 'd':
+					limits.depth = atoi(argv[++i]);
+					continue;
+				case 'n':
+					limits.nodes = strtoull(argv[++i], nullptr, 10);
+					continue;
+				case 'm':
+					limits.movetime = atoi(argv[++i]);
+					continue;
+				case 't':
+					threads = atoi(argv[++i]);
+					continue;
+				case 'H':
+					hash_mb = atoi(argv[++i]);
+					continue;
+				default:
+					return (usage(argv[0]));
+			}
+		}
+		if (strcmp(argv[i], "bench") == 0 && !fen[0])
+		{
+			run_bench = true;
+			continue;
+		}
+		// A FEN may come as one quoted argument or as separate words
+		len = strlen(fen);
+		snprintf(fen + len, sizeof(fen) - len, "%s%s", len ? " " : "",
+				argv[i]);
+	}
+	table = new TranspositionTable(hash_mb > 0 ? hash_mb : 1);
+	if (run_bench)
+	{
+		bench(limits.depth > 0 ? limits.depth : 8,
+				threads > 0 ? threads : 16, table);
+		delete table;
+		return (0);
+	}
+	if (!limits.depth && !limits.nodes && !limits.movetime)
+		limits.movetime = 5000;
+	if (!pos.setFen(fen[0] ? fen : START_FEN))
+	{
+		fprintf(stderr, "Invalid FEN: %s\n", fen);
+		delete table;
+		return (1);
+	}
+
+	search = new LazySmp(table, threads > 0 ? threads : 1);
+	search->setReport(report, nullptr);
+	result = search->run(pos, limits);
+
+	if (result.best_move.isNull())
+		printf("bestmove (none)\n");
+	else
+	{
+		moveName(result.best_move, name);
+		printf("bestmove %s\n", name);
+	}
+	printf("nodes %llu time %.3f nps %llu\n",
+			(unsigned long long) result.nodes, result.seconds,
+			(unsigned long long) result.nps);
+	delete search;
+	delete table;
+	return (0);
+}
@@ -0,0 +1,182 @@
+#include "../headers/game_db.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * elapsedSeconds - Seconds elapsed since a starting instant
+ *
+ * @start: Starting instant
+ *
+ * Return: Elapsed time in seconds
+ */
+static double elapsedSeconds(std::chrono::steady_clock::time_point start)
+{
+	return (std::chrono::duration<double>(std::chrono::steady_clock::now() -
+				start).count());
+}
+
+/**
+ * usage - Prints how to run the tool
+ *
+ * @name: Name the tool was invoked as
+ *
+ * Return: Always 2
+ */
+static int usage(const char *name)
+{
+	fprintf(stderr, "usage: %s build <out.db> <file.pgn>...\n"
+			"       %s find <file.db> [-n max] [FEN]\n\n"
+			"build writes the games of the PGN files to a database indexed by\n"
+			"position. find lists the games reaching a position, the start\n"
+			"position by default, and at most max of them, 20 by default\n",
+			name, name);
+	return (2);
+}
+
+/**
+ * build - Reads PGN files into a new database
+ *
+ * @out: Database to write
+ * @paths: PGN files to read
+ * @count: Number of PGN files
+ *
+ * Return: Exit status of the tool
+ */
+static int build(const char *out, char **paths, int count)
+{
+	std::chrono::steady_clock::time_point start;
+	GameDbWriter *writer;
+	PgnReader *reader;
+	PgnGame *game;
+	FILE *file;
+	uint64_t skipped;
+	double read_seconds;
+
+	writer = new GameDbWriter();
+	game = new PgnGame;
+	skipped = 0;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < count; i++)
+	{
+		file = strcmp(paths[i], "-") == 0 ? stdin : fopen(paths[i], "r");
+		if (file == nullptr)
+		{
+			fprintf(stderr, "Unable to open %s\n", paths[i]);
+			continue;
+		}
+		reader = new PgnReader(file);
+		while (reader->next(*game))
+		{
+			if (!writer->add(*game))
+				skipped++;
+		}
+		delete reader;
+		if (file != stdin)
+			fclose(file);
+	}
+	delete game;
+	read_seconds = elapsedSeconds(start);
+
+	if (!writer->write(out))
+	{
+		fprintf(stderr, "Unable to write %s\n", out);
+		delete writer;
+		return (1);
+	}
+	printf("games %llu positions %llu skipped %llu\n",
+			(unsigned long long) writer->games(),
+			(unsigned long long) writer->positions(),
+			(unsigned long long) skipped);
+	printf("read %.3f s, sorted and written %.3f s\n", read_seconds,
+			elapsedSeconds(start) - read_seconds);
+	delete writer;
+	return (0);
+}
+
+/**
+ * find - Lists the games of a database reaching a position, with the move
+ * each played from there
+ *
+ * @path: Database to open
+ * @fen: FEN of the position
+ * @max: Most games to list
+ *
+ * Return: Exit status of the tool
+ */
+static int find(const char *path, const char *fen, uint64_t max)
+{
+	std::chrono::steady_clock::time_point start;
+	const GameDbEntry *entries;
+	GameDb db;
+	Position pos;
+	uint64_t count;
+	double open_seconds, find_seconds;
+
+	if (!pos.setFen(fen))
+	{
+		fprintf(stderr, "Invalid FEN: %s\n", fen);
+		return (1);
+	}
+	start = std::chrono::steady_clock::now();
+	if (!db.open(path))
+	{
+		fprintf(stderr, "Unable to open %s as a game database\n", path);
+		return (1);
+	}
+	open_seconds = elapsedSeconds(start);
+	start = std::chrono::steady_clock::now();
+	entries = db.find(pos.key(), &count);
+	find_seconds = elapsedSeconds(start);
+
+	printf("%llu games, %llu positions, mapped in %.3f ms\n",
+			(unsigned long long) db.gameCount(),
+			(unsigned long long) db.positionCount(), open_seconds * 1000);
+	printf("%llu hits in %.3f ms\n", (unsigned long long) count,
+			find_seconds * 1000);
+	for (uint64_t i = 0; i < count && i < max; i++)
+	{
+		const GameDbRecord &game = db.game(entries[i].game);
+		char name[6];
+
+		if (entries[i].ply < game.move_count)
+			moveName(db.move(entries[i].game, entries[i].ply), name);
+		else
+			strcpy(name, "end");
+		printf("%u. %s - %s %s (%s), ply %u, then %s\n", entries[i].game + 1,
+				db.string(game.white), db.string(game.black),
+				db.string(game.result), db.string(game.date),
+				entries[i].ply, name);
+	}
+	return (0);
+}
+
+int main(int argc, char *argv[])
+{
+	char fen[256];
+	uint64_t max;
+
+	if (argc >= 4 && strcmp(argv[1], "build") == 0)
+		return (build(argv[2], argv + 3, argc - 3));
+	if (argc < 3 || strcmp(argv[1], "find") != 0)
+		return (usage(argv[0]));
+
+	max = 20;
+	fen[0] = '\0';
+	for (int i = 3; i < argc; i++)
+	{
+		size_t len;
+
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+		{
+			max = strtoull(argv[++i], nullptr, 10);
+			continue;
+		}
+		// A FEN may come as one quoted argument or as separate words
+		len = strlen(fen);
+		snprintf(fen + len, sizeof(fen) - len, "%s%s", len ? " " : "",
+				argv[i]);
+	}
+	return (find(argv[2], fen[0] ? fen : START_FEN, max));
+}
@@ -0,0 +1,252 @@
+#include "../headers/perft.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * struct Reference - A reference position with its published perft results
+ *
+ * @name: Short name usable on the command line
+ * @fen: FEN of the position
+ * @nodes: Leaf counts for depths 1 to 6, 0 where not listed
+ */
+struct Reference
+{
+	const char *name;
+	const char *fen;
+	uint64_t nodes[6];
+};
+
+static const Reference references[] = {
+	{ "startpos", START_FEN,
+		{ 20, 400, 8902, 197281, 4865609, 119060324 } },
+	{ "kiwipete",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		{ 48, 2039, 97862, 4085603, 193690690, 0 } },
+	{ "position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+		{ 14, 191, 2812, 43238, 674624, 11030083 } },
+	{ "position4",
+		"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+		{ 6, 264, 9467, 422333, 15833292, 0 } },
+	{ "position5",
+		"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+		{ 44, 1486, 62379, 2103487, 89941194, 0 } },
+	{ "position6",
+		"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+		{ 46, 2079, 89890, 3894594, 164075551, 0 } }
+};
+
+static const int reference_count = sizeof(references) / sizeof(references[0]);
+
+/**
+ * elapsedSeconds - Seconds elapsed since a starting instant
+ *
+ * @start: Starting instant
+ *
+ * Return: Elapsed time in seconds
+ */
+static double elapsedSeconds(std::chrono::steady_clock::time_point start)
+{
+	return (std::chrono::duration<double>(std::chrono::steady_clock::now() -
+				start).count());
+}
+
+/**
+ * divide - Prints the leaf count below each root move, then the total and
+ * the nodes per second
+ *
+ * @pos: Position to count from
+ * @depth: Number of plies to walk
+ * @threads: Number of threads, 0 for the plain single threaded perft
+ * @table: Node count cache shared by the threads, may be nullptr
+ *
+ * Return: Total number of leaf nodes
+ */
+static uint64_t divide(Position &pos, int depth, int threads,
+		PerftTable *table)
+{
+	std::chrono::steady_clock::time_point start;
+	uint64_t root_nodes[MAX_MOVES];
+	MoveList list;
+	uint64_t total;
+	double seconds;
+
+	start = std::chrono::steady_clock::now();
+	pos.generateLegalMoves(list);
+	if (threads)
+		total = parallelPerft(pos, depth, threads, table, root_nodes);
+	else
+	{
+		total = 0;
+		for (int i = 0; i < list.size(); i++)
+		{
+			pos.makeMove(list[i]);
+			root_nodes[i] = perft(pos, depth - 1);
+			pos.unmakeMove();
+			total += root_nodes[i];
+		}
+	}
+	seconds = elapsedSeconds(start);
+
+	for (int i = 0; i < list.size(); i++)
+	{
+		char name[6];
+
+		moveName(list[i], name);
+		printf("%s: %llu\n", name, (unsigned long long) root_nodes[i]);
+	}
+	printf("\nMoves: %d\nNodes searched: %llu\nTime: %.3f s\nNPS: %.0f\n",
+			list.size(), (unsigned long long) total, seconds,
+			seconds > 0 ? total / seconds : 0.0);
+	return (total);
+}
+
+/**
+ * runSuite - Runs perft on every reference position up to a depth and checks
+ * the results against the published counts
+ *
+ * @max_depth: Deepest depth to run, capped to the known results
+ * @threads: Number of threads, 0 for the plain single threaded perft
+ * @table: Node count cache shared by the threads, may be nullptr
+ *
+ * Return: 0 if every count matched, 1 otherwise
+ */
+static int runSuite(int max_depth, int threads, PerftTable *table)
+{
+	std::chrono::steady_clock::time_point start;
+	uint64_t total;
+	double seconds;
+	int failures;
+
+	start = std::chrono::steady_clock::now();
+	total = 0;
+	failures = 0;
+	for (int i = 0; i < reference_count; i++)
+	{
+		Position pos;
+
+		pos.setFen(references[i].fen);
+		for (int depth = 1; depth <= max_depth && depth <= 6; depth++)
+		{
+			uint64_t expected, nodes;
+
+			expected = references[i].nodes[depth - 1];
+			if (!expected)
+				break;
+			nodes = threads ? parallelPerft(pos, depth, threads, table, nullptr)
+				: perft(pos, depth);
+			total += nodes;
+			printf("%-10s depth %d: %12llu %s\n", references[i].name, depth,
+					(unsigned long long) nodes, nodes == expected ? "ok" :
+					"MISMATCH");
+			if (nodes != expected)
+			{
+				printf("%-10s expected %12llu\n", "",
+						(unsigned long long) expected);
+				failures++;
+			}
+		}
+	}
+	seconds = elapsedSeconds(start);
+	printf("\n%d mismatch(es), %llu nodes in %.3f s, %.0f NPS\n", failures,
+			(unsigned long long) total, seconds,
+			seconds > 0 ? total / seconds : 0.0);
+	return (failures ? 1 : 0);
+}
+
+/**
+ * usage - Prints how to run the tool
+ *
+ * @name: Name the tool was invoked as
+ *
+ * Return: Always 2
+ */
+static int usage(const char *name)
+{
+	fprintf(stderr, "usage: %s <depth> [position name | FEN] [options]\n"
+			"       %s suite [max depth] [options]\n\n"
+			"options:\n"
+			"  -t <threads>  count in parallel with a work stealing pool\n"
+			"  -H <MB>       share subtree counts through a hash table\n"
+			"\npositions:", name, name);
+	for (int i = 0; i < reference_count; i++)
+		fprintf(stderr, " %s", references[i].name);
+	fprintf(stderr, "\n");
+	return (2);
+}
+
+int main(int argc, char *argv[])
+{
+	PerftTable *table;
+	const char *args[64];
+	Position pos;
+	char fen[256];
+	int depth, threads, hash_mb, nargs, status;
+
+	// Split the options off the positional arguments
+	threads = 0;
+	hash_mb = 0;
+	nargs = 0;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+			threads = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-H") == 0 && i + 1 < argc)
+			hash_mb = atoi(argv[++i]);
+		else if (nargs < 64)
+			args[nargs++] = argv[i];
+	}
+	if (nargs < 1)
+		return (usage(argv[0]));
+	if (hash_mb > 0 && threads < 1)
+		threads = 1;
+	table = hash_mb > 0 ? new PerftTable(hash_mb) : nullptr;
+
+	if (strcmp(args[0], "suite") == 0)
+	{
+		status = runSuite(nargs > 1 ? atoi(args[1]) : 4, threads, table);
+		delete table;
+		return (status);
+	}
+
+	depth = atoi(args[0]);
+	if (depth < 1)
+	{
+		delete table;
+		return (usage(argv[0]));
+	}
+
+	// A FEN may come as one quoted argument or as separate words
+	strcpy(fen, START_FEN);
+	if (nargs > 1)
+	{
+		const char *named;
+
+		named = nullptr;
+		for (int i = 0; i < reference_count; i++)
+			if (strcmp(args[1], references[i].name) == 0)
+				named = references[i].fen;
+		fen[0] = '\0';
+		if (named)
+			snprintf(fen, sizeof(fen), "%s", named);
+		for (int i = 1; !named && i < nargs; i++)
+		{
+			size_t len;
+
+			len = strlen(fen);
+			snprintf(fen + len, sizeof(fen) - len, "%s%s", args[i],
+					i + 1 < nargs ? " " : "");
+		}
+	}
+	status = 0;
+	if (pos.setFen(fen))
+		divide(pos, depth, threads, table);
+	else
+	{
+		fprintf(stderr, "Invalid FEN: %s\n", fen);
+		status = 1;
+	}
+	delete table;
+	return (status);
+}
@@ -0,0 +1,114 @@
+#include "../headers/pgn.h"
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * usage - Prints how to run the tool
+ *
+ * @name: Name the tool was invoked as
+ *
+ * Return: Always 2
+ */
+static int usage(const char *name)
+{
+	fprintf(stderr, "usage: %s [-v] <file.pgn>...\n\n"
+			"Replays every game of the files through the move generator and\n"
+			"prints how fast they were read, '-' reads the standard input.\n"
+			"-v also prints one line per game, with the final position\n",
+			name);
+	return (2);
+}
+
+/**
+ * printGame - Prints a line about a game read, and the FEN it ends on
+ *
+ * @number: Number of the game, counted from 1 across all files
+ * @game: Game read
+ *
+ * Return: Nothing
+ */
+static void printGame(uint64_t number, const PgnGame &game)
+{
+	Position pos;
+	char fen[MAX_FEN_LENGTH];
+
+	pos.setFen(game.fen[0] ? game.fen : START_FEN);
+	for (int i = 0; i < game.move_count; i++)
+		pos.makeMove(game.moves[i]);
+	pos.getFen(fen);
+	printf("%llu. %s - %s %s, %d plies%s\n   %s\n",
+			(unsigned long long) number, game.white, game.black,
+			game.result, game.move_count,
+			game.error ? " (stopped at an unreadable move)" : "", fen);
+}
+
+int main(int argc, char *argv[])
+{
+	std::chrono::steady_clock::time_point start;
+	PgnReader *reader;
+	PgnGame *game;
+	FILE *file;
+	uint64_t games, moves, errors, bytes;
+	double seconds;
+	bool verbose;
+	int files;
+
+	verbose = false;
+	files = 0;
+	games = 0;
+	moves = 0;
+	errors = 0;
+	bytes = 0;
+	game = new PgnGame;
+	start = std::chrono::steady_clock::now();
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-v") == 0)
+		{
+			verbose = true;
+			continue;
+		}
+		if (argv[i][0] == '-' && argv[i][1])
+		{
+			delete game;
+			return (usage(argv[0]));
+		}
+		file = strcmp(argv[i], "-") == 0 ? stdin : fopen(argv[i], "r");
+		if (file == nullptr)
+		{
+			fprintf(stderr, "Unable to open %s\n", argv[i]);
+			continue;
+		}
+		files++;
+
+		// The reader holds a whole position and read buffer, keep it off
+		// the stack
+		reader = new PgnReader(file);
+		while (reader->next(*game))
+		{
+			if (verbose)
+				printGame(games + reader->games(), *game);
+		}
+		games += reader->games();
+		moves += reader->moves();
+		errors += reader->errors();
+		bytes += reader->bytes();
+		delete reader;
+		if (file != stdin)
+			fclose(file);
+	}
+	delete game;
+	if (files == 0)
+		return (usage(argv[0]));
+
+	seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+			start).count();
+	printf("games %llu moves %llu errors %llu in %.3f s\n",
+			(unsigned long long) games, (unsigned long long) moves,
+			(unsigned long long) errors, seconds);
+	if (seconds > 0)
+		printf("%.0f games/s %.0f moves/s %.1f MB/s\n", games / seconds,
+				moves / seconds, bytes / seconds / (1 << 20));
+	return (errors ? 1 : 0);
+}
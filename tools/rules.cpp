@@ -0,0 +1,590 @@
+#include "../headers/game_db.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * struct Section - A group of checks that can be run on its own
+ *
+ * @name: Short name usable on the command line
+ * @run: Function running the checks
+ */
+struct Section
+{
+	const char *name;
+	void (*run)(void);
+};
+
+// Checks run and failed so far
+static int checks;
+static int failures;
+
+/**
+ * expect - Counts a check, printing it when it fails
+ *
+ * @ok: Whether or not the check passed
+ * @what: Description of the check
+ *
+ * Return: Nothing
+ */
+static void expect(bool ok, const char *what)
+{
+	checks++;
+	if (ok)
+		return;
+	failures++;
+	printf("  FAIL %s\n", what);
+}
+
+/**
+ * nextRandom - Steps a xorshift generator, so random games are the same on
+ * every run
+ *
+ * @state: Generator state, never 0
+ *
+ * Return: The next random number
+ */
+static uint64_t nextRandom(uint64_t *state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return (*state);
+}
+
+/**
+ * play - Plays moves given in coordinate notation, e.g. "g1f3 g8f6"
+ *
+ * @pos: Position to play the moves on
+ * @moves: Moves separated by spaces
+ *
+ * Return: true if every move was legal and played, false otherwise
+ */
+static bool play(Position &pos, const char *moves)
+{
+	MoveList list;
+	char token[8], name[6];
+	int len, i;
+
+	while (*moves)
+	{
+		len = 0;
+		while (*moves && *moves != ' ')
+		{
+			if (len < (int) sizeof(token) - 1)
+				token[len++] = *moves;
+			moves++;
+		}
+		token[len] = '\0';
+		while (*moves == ' ')
+			moves++;
+		if (len == 0)
+			continue;
+
+		pos.generateLegalMoves(list);
+		for (i = 0; i < list.size(); i++)
+		{
+			moveName(list[i], name);
+			if (strcmp(name, token) == 0)
+				break;
+		}
+		if (i == list.size())
+			return (false);
+		pos.makeMove(list[i]);
+	}
+	return (true);
+}
+
+/**
+ * checkDraws - Checks threefold repetition and the fifty-move rule on short
+ * games
+ *
+ * Return: Nothing
+ */
+static void checkDraws(void)
+{
+	Position pos;
+	char out[MAX_FEN_LENGTH];
+
+	pos.setFen(START_FEN);
+	expect(play(pos, "g1f3 g8f6 f3g1 f6g8") && pos.isRepetition(1) &&
+			pos.drawState() == NO_DRAW, "second occurrence is no draw");
+	expect(play(pos, "g1f3 g8f6 f3g1") && pos.drawState() == NO_DRAW,
+			"no draw before the third occurrence");
+	expect(play(pos, "f6g8") && pos.drawState() == REPETITION_DRAW,
+			"third occurrence draws");
+
+	pos.setFen(START_FEN);
+	play(pos, "g1f3 g8f6 f3g1 f6g8 e2e4 e7e5 g1f3 g8f6 f3g1 f6g8");
+	expect(pos.isRepetition(1) && !pos.isRepetition(2),
+			"a pawn move ends the repetitions before it");
+
+	// The pieces come back to their grids, but the castling rights do not
+	pos.setFen(START_FEN);
+	play(pos, "g1f3 g8f6 h1g1 h8g8 g1h1 g8h8 f3g1 f6g8");
+	expect(!pos.isRepetition(1), "lost castling rights are a new position");
+
+	pos.setFen("8/8/8/4k3/8/8/8/4K2R w K - 98 80");
+	expect(play(pos, "h1h2") && pos.drawState() == NO_DRAW,
+			"ninety-nine plies are no draw");
+	expect(play(pos, "e5e4") && pos.drawState() == FIFTY_MOVE_DRAW,
+			"a hundred plies draw");
+
+	pos.setFen("8/8/8/4k3/8/8/7p/4K2R w K - 99 80");
+	expect(play(pos, "h1h2") && pos.halfmoveClock() == 0 &&
+			pos.drawState() == NO_DRAW, "a capture resets the clock");
+
+	pos.setFen("k7/8/1K6/8/8/8/8/7R w - - 99 80");
+	expect(play(pos, "h1h8") && pos.halfmoveClock() == 100 &&
+			pos.drawState() == NO_DRAW, "mate on the hundredth ply wins");
+
+	// Games longer than the undo stack keep every ply
+	pos.setFen(START_FEN);
+	for (int i = 0; i < MAX_GAME_PLY; i++)
+		play(pos, "g1f3 g8f6 f3g1 f6g8");
+	expect(pos.undoSize() == 4 * MAX_GAME_PLY &&
+			pos.drawState() == REPETITION_DRAW, "long game history kept");
+	while (pos.undoSize())
+		pos.unmakeMove();
+	pos.getFen(out);
+	expect(strcmp(out, START_FEN) == 0, "long game taken back");
+}
+
+/**
+ * fenBecomes - Sets a FEN up and checks the FEN written back
+ *
+ * @fen: FEN to set up
+ * @expected: FEN that should be written back
+ *
+ * Return: true if fen was read and written back as expected
+ */
+static bool fenBecomes(const char *fen, const char *expected)
+{
+	Position pos;
+	char out[MAX_FEN_LENGTH];
+
+	if (!pos.setFen(fen))
+		return (false);
+	pos.getFen(out);
+	return (strcmp(out, expected) == 0);
+}
+
+/**
+ * checkFen - Checks that FENs are read and written back unchanged, that
+ * rights the position cannot have are dropped, and that malformed ones are
+ * refused
+ *
+ * Return: Nothing
+ */
+static void checkFen(void)
+{
+	static const char *const fens[] = {
+		START_FEN,
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+		"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+		"4k3/8/8/8/8/8/8/4K3 b - - 37 112"
+	};
+	char out[MAX_FEN_LENGTH], again[MAX_FEN_LENGTH];
+	Position pos, copy;
+	MoveList list;
+	uint64_t state;
+	bool same;
+
+	for (size_t i = 0; i < sizeof(fens) / sizeof(fens[0]); i++)
+		expect(fenBecomes(fens[i], fens[i]), fens[i]);
+	expect(fenBecomes("4k3/8/8/8/8/8/8/4K3 w KQkq e6",
+				"4k3/8/8/8/8/8/8/4K3 w - - 0 1"),
+			"impossible rights and missing clocks");
+	expect(fenBecomes(
+				"rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1",
+				"rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1"),
+			"en passant grid no pawn can take on");
+
+	expect(!pos.setFen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR"),
+			"missing side to move");
+	expect(!pos.setFen(
+				"rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w - - 0 1"),
+			"rank too long");
+	expect(!pos.setFen("rnbqkbnr/pppppppp/8/8/8/PPPPPPPP/RNBQKBNR w - - 0 1"),
+			"seven ranks");
+	expect(!pos.setFen("4k3/8/8/8/8/8/8/4KK2 w - - 0 1"),
+			"two white kings");
+	expect(!pos.setFen("P3k3/8/8/8/8/8/8/4K3 w - - 0 1"),
+			"pawn on the last rank");
+
+	pos.setFen(START_FEN);
+	play(pos, "e2e4 c7c5 g1f3");
+	pos.getFen(out);
+	expect(strcmp(out, "rnbqkbnr/pp1ppppp/8/2p5/4P3/5N2/PPPP1PPP/RNBQKB1R"
+				" b KQkq - 1 2") == 0, "FEN after 1. e4 c5 2. Nf3");
+
+	// Positions reached by random games read back to the same FEN and key,
+	// and taking every move back returns to the start
+	state = 0x2545f4914f6cdd1dULL;
+	same = true;
+	pos.setFen(START_FEN);
+	for (int ply = 0; ply < 300; ply++)
+	{
+		pos.generateLegalMoves(list);
+		if (list.size() == 0)
+			break;
+		pos.makeMove(list[nextRandom(&state) % list.size()]);
+		pos.getFen(out);
+		if (!copy.setFen(out))
+		{
+			same = false;
+			break;
+		}
+		copy.getFen(again);
+		same = same && strcmp(out, again) == 0 && copy.key() == pos.key();
+	}
+	expect(same, "random game positions read back unchanged");
+	while (pos.undoSize())
+		pos.unmakeMove();
+	pos.getFen(out);
+	expect(strcmp(out, START_FEN) == 0, "random game taken back");
+}
+
+/**
+ * sanIs - Reads a SAN move in a position and checks the move found
+ *
+ * @fen: FEN of the position
+ * @san: SAN move to read
+ * @expected: Move expected in coordinate notation, nullptr if san should
+ * be refused
+ *
+ * Return: true if san was read as expected
+ */
+static bool sanIs(const char *fen, const char *san, const char *expected)
+{
+	Position pos;
+	CompactMove move;
+	char name[6];
+
+	if (!pos.setFen(fen))
+		return (false);
+	move = pos.parseSan(san, strlen(san));
+	if (move.isNull())
+		return (expected == nullptr);
+	moveName(move, name);
+	return (expected && strcmp(name, expected) == 0);
+}
+
+/**
+ * checkSan - Checks SAN moves with disambiguation, promotions, castling and
+ * en passant, and that malformed, illegal and ambiguous ones are refused
+ *
+ * Return: Nothing
+ */
+static void checkSan(void)
+{
+	const char *knights, *rooks, *promotion, *castling, *ep;
+
+	knights = "4k3/8/8/8/8/8/8/1N2KN2 w - - 0 1";
+	expect(sanIs(knights, "Nd2", nullptr), "Nd2 is ambiguous");
+	expect(sanIs(knights, "Nbd2", "b1d2"), "Nbd2");
+	expect(sanIs(knights, "Nfd2", "f1d2"), "Nfd2");
+	expect(sanIs(knights, "Nb1d2", "b1d2"), "Nb1d2");
+	expect(sanIs(knights, "Nc3", "b1c3"), "Nc3");
+
+	rooks = "k7/8/8/8/8/4R3/8/K3R3 w - - 0 1";
+	expect(sanIs(rooks, "Re2", nullptr), "Re2 is ambiguous");
+	expect(sanIs(rooks, "R1e2", "e1e2"), "R1e2");
+	expect(sanIs(rooks, "R3e2", "e3e2"), "R3e2");
+	expect(sanIs(rooks, "Rea8", nullptr), "Rea8 is illegal");
+
+	promotion = "3r3k/4P3/8/8/8/8/8/K7 w - - 0 1";
+	expect(sanIs(promotion, "e8=Q+", "e7e8q"), "e8=Q+");
+	expect(sanIs(promotion, "e8Q", "e7e8q"), "e8Q");
+	expect(sanIs(promotion, "exd8=N", "e7d8n"), "exd8=N");
+	expect(sanIs(promotion, "e8", nullptr), "e8 without a piece");
+	expect(sanIs(promotion, "e8=K", nullptr), "e8=K");
+
+	castling = "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1";
+	expect(sanIs(castling, "O-O", "e1g1"), "O-O");
+	expect(sanIs(castling, "0-0-0", "e1c1"), "0-0-0");
+	expect(sanIs(castling, "O-O-O+", "e1c1"), "O-O-O+");
+	expect(sanIs(castling, "O-0", nullptr), "O-0");
+	expect(sanIs("r3k2r/8/8/8/8/8/8/R3K2R w - - 0 1", "O-O", nullptr),
+			"O-O without the right");
+	expect(sanIs(castling, "Kg1", nullptr), "Kg1 is not castling");
+
+	ep = "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3";
+	expect(sanIs(ep, "exf6", "e5f6"), "exf6 en passant");
+	expect(sanIs(ep, "exd6", nullptr), "exd6 without the right");
+	expect(sanIs(ep, "e6!?", "e5e6"), "e6!?");
+
+	expect(sanIs(START_FEN, "", nullptr), "empty move");
+	expect(sanIs(START_FEN, "e9", nullptr), "e9");
+	expect(sanIs(START_FEN, "Zf3", nullptr), "Zf3");
+	expect(sanIs(START_FEN, "Nf6", nullptr), "Nf6 for white");
+}
+
+/**
+ * textFile - Writes a text to a temporary file, removed once closed
+ *
+ * @text: Text to write
+ *
+ * Return: The file, rewound, nullptr on failure
+ */
+static FILE *textFile(const char *text)
+{
+	FILE *file;
+
+	file = tmpfile();
+	if (file == nullptr)
+		return (nullptr);
+	fputs(text, file);
+	rewind(file);
+	return (file);
+}
+
+/**
+ * movesAre - Checks the moves of a game read from PGN
+ *
+ * @game: Game read
+ * @expected: Moves expected in coordinate notation, separated by spaces
+ *
+ * Return: true if the game has exactly the expected moves
+ */
+static bool movesAre(const PgnGame &game, const char *expected)
+{
+	char names[PGN_TOKEN_LENGTH * 8], *out;
+
+	out = names;
+	for (int i = 0; i < game.move_count && i < 8; i++)
+	{
+		if (i)
+			*out++ = ' ';
+		moveName(game.moves[i], out);
+		out += strlen(out);
+	}
+	*out = '\0';
+	return (game.move_count <= 8 && strcmp(names, expected) == 0);
+}
+
+/**
+ * checkPgn - Reads games through comments, variations, NAGs and escapes,
+ * and checks where unreadable games stop
+ *
+ * Return: Nothing
+ */
+static void checkPgn(void)
+{
+	static const char *const text =
+		"[Event \"Test\"]\n"
+		"[White \"A\"]\n"
+		"[Black \"B\"]\n"
+		"[Result \"1-0\"]\n"
+		"\n"
+		"% 1. d4 on an escaped line\n"
+		"1.e4 {1. d4 in a comment} e5 2. Nf3 $1 (2. Nc3 (2. f4) Nc6)\n"
+		"2... Nc6 ; 3. d4 on a commented line\n"
+		"3. Bb5 a6 1-0\n"
+		"\n"
+		"[FEN \"4k3/P7/8/8/8/8/8/4K3 w - - 0 1\"]\n"
+		"\n"
+		"1. a8=Q+ Kd7 *\n"
+		"\n"
+		"1. e4 %e5 *\n"
+		"\n"
+		"1. e4 e4 0-1\n"
+		"\n"
+		"[Event \"No result\"]\n"
+		"1. d4\n"
+		"[Event \"Next\"]\n"
+		"1. c4 1/2-1/2\n";
+	PgnReader *reader;
+	PgnGame *game;
+	FILE *file;
+
+	file = textFile(text);
+	if (file == nullptr)
+	{
+		expect(false, "temporary file");
+		return;
+	}
+	reader = new PgnReader(file);
+	game = new PgnGame;
+
+	expect(reader->next(*game) && !game->error &&
+			strcmp(game->event, "Test") == 0 &&
+			strcmp(game->white, "A") == 0 &&
+			strcmp(game->result, "1-0") == 0 &&
+			movesAre(*game, "e2e4 e7e5 g1f3 b8c6 f1b5 a7a6"),
+			"comments, variations, NAGs and escaped lines skipped");
+	expect(reader->next(*game) && !game->error &&
+			strcmp(game->fen, "4k3/P7/8/8/8/8/8/4K3 w - - 0 1") == 0 &&
+			strcmp(game->result, "*") == 0 &&
+			movesAre(*game, "a7a8q e8d7"), "game set up by a FEN tag");
+	expect(reader->next(*game) && game->error && game->fen[0] == '\0' &&
+			strcmp(game->result, "*") == 0 && movesAre(*game, "e2e4"),
+			"'%' within a line is no escape");
+	expect(reader->next(*game) && game->error &&
+			strcmp(game->result, "0-1") == 0 && movesAre(*game, "e2e4"),
+			"game stopped at an illegal move");
+	expect(reader->next(*game) && !game->error &&
+			strcmp(game->event, "No result") == 0 &&
+			game->result[0] == '\0' && movesAre(*game, "d2d4"),
+			"game without a result ends at the next tags");
+	expect(reader->next(*game) && strcmp(game->event, "Next") == 0 &&
+			movesAre(*game, "c2c4"), "game after one without a result");
+	expect(!reader->next(*game) && reader->games() == 6 &&
+			reader->errors() == 2 && reader->moves() == 12,
+			"end of the file");
+
+	delete game;
+	delete reader;
+	fclose(file);
+}
+
+/**
+ * checkGameDb - Builds a database from a few games, one reaching a position
+ * of another by a different order of moves, and looks positions up in it
+ *
+ * Return: Nothing
+ */
+static void checkGameDb(void)
+{
+	static const char *const text =
+		"[White \"A\"]\n1. e4 e5 2. Nf3 Nc6 *\n"
+		"[White \"B\"]\n1. Nf3 Nc6 2. e4 e5 3. Bb5 *\n"
+		"[White \"C\"]\n[FEN \"4k3/8/8/8/8/8/8/4K3 w - - 0 1\"]\n"
+		"1. Kd2 *\n";
+	char path[] = "/tmp/rules-db-XXXXXX";
+	const GameDbEntry *entries;
+	GameDbWriter *writer;
+	PgnReader *reader;
+	PgnGame *game;
+	GameDb db;
+	Position pos;
+	FILE *file;
+	uint64_t count;
+	int fd;
+	bool written;
+
+	file = textFile(text);
+	fd = mkstemp(path);
+	if (file == nullptr || fd < 0)
+	{
+		expect(false, "temporary files");
+		if (file)
+			fclose(file);
+		return;
+	}
+	close(fd);
+	writer = new GameDbWriter();
+	reader = new PgnReader(file);
+	game = new PgnGame;
+	while (reader->next(*game))
+		writer->add(*game);
+	written = writer->write(path);
+	expect(written && writer->games() == 3 && writer->positions() == 13,
+			"database written");
+	delete game;
+	delete reader;
+	delete writer;
+	fclose(file);
+
+	expect(db.open(path) && db.gameCount() == 3 && db.positionCount() == 13,
+			"database opened");
+	expect(strcmp(db.string(db.game(1).white), "B") == 0 &&
+			strcmp(db.string(db.game(2).fen),
+				"4k3/8/8/8/8/8/8/4K3 w - - 0 1") == 0 &&
+			db.string(db.game(0).fen)[0] == '\0', "tags read back");
+
+	pos.setFen(START_FEN);
+	entries = db.find(pos.key(), &count);
+	expect(count == 2 && entries[0].game == 0 && entries[0].ply == 0 &&
+			entries[1].game == 1 && entries[1].ply == 0,
+			"start position in both games from it");
+
+	// 1. e4 e5 2. Nf3 Nc6 and 1. Nf3 Nc6 2. e4 e5 meet
+	play(pos, "e2e4 e7e5 g1f3 b8c6");
+	entries = db.find(pos.key(), &count);
+	expect(count == 2 && entries[0].game == 0 && entries[0].ply == 4 &&
+			entries[1].game == 1 && entries[1].ply == 4,
+			"transposition found in both games");
+	expect(count == 2 && entries[1].ply < db.game(1).move_count &&
+			db.move(1, entries[1].ply).from() == square(2, 0) &&
+			db.move(1, entries[1].ply).to() == square(6, 4),
+			"move played from the position");
+
+	play(pos, "f1c4");
+	expect(db.find(pos.key(), &count) == nullptr && count == 0,
+			"position no game reaches");
+	db.close();
+	expect(db.gameCount() == 0, "database closed");
+
+	file = fopen(path, "w");
+	if (file)
+	{
+		fputs("not a game database, yet long enough for a header\n", file);
+		fclose(file);
+	}
+	expect(!db.open(path), "other files refused");
+	unlink(path);
+	expect(!db.open(path), "missing file refused");
+}
+
+static const Section sections[] = {
+	{ "draws", checkDraws },
+	{ "fen", checkFen },
+	{ "san", checkSan },
+	{ "pgn", checkPgn },
+	{ "gamedb", checkGameDb }
+};
+
+static const int section_count = sizeof(sections) / sizeof(sections[0]);
+
+/**
+ * usage - Prints how to run the tool
+ *
+ * @name: Name the tool was invoked as
+ *
+ * Return: Always 2
+ */
+static int usage(const char *name)
+{
+	fprintf(stderr, "usage: %s [section]...\n\n"
+			"Checks the rules core against known positions and games, every\n"
+			"section by default. The sections are:\n", name);
+	for (int i = 0; i < section_count; i++)
+		fprintf(stderr, "  %s\n", sections[i].name);
+	return (2);
+}
+
+int main(int argc, char *argv[])
+{
+	bool found;
+
+	for (int i = 1; i < argc; i++)
+	{
+		found = false;
+		for (int j = 0; j < section_count; j++)
+			found = found || strcmp(argv[i], sections[j].name) == 0;
+		if (!found)
+			return (usage(argv[0]));
+	}
+
+	for (int i = 0; i < section_count; i++)
+	{
+		int before_checks, before_failures;
+
+		found = argc == 1;
+		for (int j = 1; j < argc; j++)
+			found = found || strcmp(argv[j], sections[i].name) == 0;
+		if (!found)
+			continue;
+		before_checks = checks;
+		before_failures = failures;
+		sections[i].run();
+		printf("%-10s %3d check(s) %s\n", sections[i].name,
+				checks - before_checks,
+				failures == before_failures ? "ok" : "FAILED");
+	}
+	printf("\n%d failure(s) in %d check(s)\n", failures, checks);
+	return (failures ? 1 : 0);
+}